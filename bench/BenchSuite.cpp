@@ -0,0 +1,414 @@
+// Benchmark suite
+// Micro and macro benchmarks of the simulation and loading paths on generated levels from
+// small to huge (fixed seeds, see core::LevelGenerator), so releases can be compared: run it before and after a change and diff
+// the CSV/JSON output. Runs headless (no window, textures or audio).
+//
+// Usage: bench_suite [--quick] [--filter TEXT] [--csv PATH] [--json PATH]
+//   --quick   shorter time budget per case (noisier, for smoke runs)
+//   --filter  only run cases whose benchmark name contains TEXT
+
+#include "world/World.hpp"
+#include "world/TileMap.hpp"
+#include "world/LevelParser.hpp"
+#include "world/CompiledLevel.hpp"
+#include "core/CustomLevelManager.hpp"
+#include "core/ResourceManager.hpp"
+#include "core/FixedTimestep.hpp"
+#include "core/LevelGenerator.hpp"
+#include "core/LevelArena.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct LevelSize {
+        const char* label;
+        int columns;
+        int enemies;
+        int flying_enemies;
+        int coins;
+    };
+
+    constexpr int LEVEL_ROWS = 14;
+
+    constexpr long long TICKS_PER_SAMPLE = 600; // 5 seconds of game time at 120 Hz
+    constexpr int QUERIES_PER_SAMPLE = 10000;
+    constexpr int LEVELS_PER_FILE = 8;
+
+    constexpr LevelSize LEVEL_SIZES[] = {
+        {"small", 64, 2, 1, 8},
+        {"medium", 512, 16, 8, 64},
+        {"large", 4096, 128, 64, 512},
+        {"huge", 32768, 1024, 512, 4096},
+        {"swarm", 16384, 4096, 1024, 2048}, // Entity-heavy: thousands of enemies
+        {"hoard", 4096, 32, 16, 16384},     // Coin-heavy: most open cells hold a coin
+    };
+
+    // One timed sample: elapsed time and how many operations it covered
+    struct Sample {
+        double ns;
+        long long ops;
+    };
+
+    struct Result {
+        std::string benchmark;
+        std::string level;
+        int columns;
+        std::string unit;   // What one operation is
+        long long samples;
+        long long ops;
+        double mean_ns;     // Per operation, over all samples
+        double median_ns;   // Per operation, median sample
+        double min_ns;      // Per operation, fastest sample
+    };
+
+    struct Options {
+        bool quick = false;
+        std::string filter;
+        std::string csv_path;
+        std::string json_path;
+    };
+
+    // Level and World constructors log to stdout; keep the report readable while measuring
+    class ScopedSilence {
+    public:
+        ScopedSilence() : m_previous(std::cout.rdbuf(m_sink.rdbuf())) {}
+        ~ScopedSilence() { std::cout.rdbuf(m_previous); }
+        ScopedSilence(const ScopedSilence&) = delete;
+        ScopedSilence& operator=(const ScopedSilence&) = delete;
+
+    private:
+        std::ostringstream m_sink;
+        std::streambuf* m_previous;
+    };
+
+    class Suite {
+    public:
+        explicit Suite(const Options& options) : m_options(options) {}
+
+        // Calls sample_fn until the time budget is spent (at least MIN_SAMPLES times);
+        // sample_fn does its own untimed setup and returns the timed part
+        void run(const std::string& benchmark, const LevelSize& size, const std::string& unit,
+                 const std::function<Sample()>& sample_fn) {
+            if (!m_options.filter.empty() && benchmark.find(m_options.filter) == std::string::npos) return;
+
+            const double budget_ns = m_options.quick ? 50e6 : 500e6;
+            const int max_samples = m_options.quick ? 20 : 1000;
+            std::vector<double> per_op;
+            double total_ns = 0.0;
+            long long total_ops = 0;
+            {
+                ScopedSilence silence;
+                sample_fn(); // Warm-up
+                while (static_cast<int>(per_op.size()) < MIN_SAMPLES ||
+                       (total_ns < budget_ns && static_cast<int>(per_op.size()) < max_samples)) {
+                    Sample sample = sample_fn();
+                    if (sample.ops <= 0) break;
+                    per_op.push_back(sample.ns / static_cast<double>(sample.ops));
+                    total_ns += sample.ns;
+                    total_ops += sample.ops;
+                }
+            }
+            if (per_op.empty()) return;
+
+            std::vector<double> sorted = per_op;
+            std::ranges::sort(sorted);
+            Result result{benchmark, size.label, size.columns, unit, static_cast<long long>(per_op.size()), total_ops,
+                          total_ns / static_cast<double>(total_ops), sorted[sorted.size() / 2], sorted.front()};
+            print(result);
+            m_results.push_back(result);
+        }
+
+        void print_header() const {
+            std::cout << std::left << std::setw(22) << "benchmark" << std::setw(8) << "level" << std::setw(9) << "columns"
+                      << std::setw(16) << "unit" << std::right << std::setw(14) << "mean ns/op" << std::setw(14)
+                      << "median ns/op" << std::setw(14) << "min ns/op" << std::setw(10) << "samples" << std::endl;
+        }
+
+        bool write_csv(const std::string& path) const {
+            std::ofstream file(path);
+            if (!file) return false;
+            file << "benchmark,level,columns,unit,samples,ops,mean_ns,median_ns,min_ns\n";
+            for (const auto& r : m_results) {
+                file << r.benchmark << ',' << r.level << ',' << r.columns << ',' << r.unit << ',' << r.samples << ','
+                     << r.ops << ',' << r.mean_ns << ',' << r.median_ns << ',' << r.min_ns << '\n';
+            }
+            return static_cast<bool>(file);
+        }
+
+        bool write_json(const std::string& path) const {
+            std::ofstream file(path);
+            if (!file) return false;
+            file << "{\n  \"results\": [\n";
+            for (size_t i = 0; i < m_results.size(); ++i) {
+                const auto& r = m_results[i];
+                file << "    {\"benchmark\": \"" << r.benchmark << "\", \"level\": \"" << r.level
+                     << "\", \"columns\": " << r.columns << ", \"unit\": \"" << r.unit << "\", \"samples\": " << r.samples
+                     << ", \"ops\": " << r.ops << ", \"mean_ns\": " << r.mean_ns << ", \"median_ns\": " << r.median_ns
+                     << ", \"min_ns\": " << r.min_ns << "}" << (i + 1 < m_results.size() ? "," : "") << "\n";
+            }
+            file << "  ]\n}\n";
+            return static_cast<bool>(file);
+        }
+
+    private:
+        void print(const Result& r) const {
+            std::cout << std::left << std::setw(22) << r.benchmark << std::setw(8) << r.level << std::setw(9) << r.columns
+                      << std::setw(16) << r.unit << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(14) << r.mean_ns << std::setw(14) << r.median_ns << std::setw(14) << r.min_ns
+                      << std::setw(10) << r.samples << std::endl;
+        }
+
+        static constexpr int MIN_SAMPLES = 3;
+
+        const Options& m_options;
+        std::vector<Result> m_results;
+    };
+
+    template <typename Fn>
+    double time_ns(Fn&& fn) {
+        auto start = Clock::now();
+        fn();
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+
+    // Stores a benchmark result where the optimiser cannot prove it unused, so the work
+    // producing it is not removed
+    volatile long long s_result_sink = 0;
+
+    void do_not_optimize(long long value) {
+        s_result_sink = value;
+    }
+
+    // Player-sized probes spread along the level at platform and ground height
+    sf::FloatRect probe_bounds(int index, int columns, float height) {
+        float x = static_cast<float>((index * 37) % columns) * world::TileMap::TILE_SIZE + 5.0f;
+        float y = static_cast<float>(LEVEL_ROWS - 4 - (index % 3)) * world::TileMap::TILE_SIZE + 10.0f;
+        return sf::FloatRect(sf::Vector2f(x, y), sf::Vector2f(32.0f, height));
+    }
+
+    void run_level_benchmarks(Suite& suite, const LevelSize& size, const std::filesystem::path& scratch_dir) {
+        core::LevelGeneratorSettings settings;
+        settings.seed = 1234;
+        settings.width = size.columns;
+        settings.height = LEVEL_ROWS;
+        settings.enemy_count = size.enemies;
+        settings.flying_enemy_count = size.flying_enemies;
+        settings.coin_count = size.coins;
+        settings.checkpoint_count = size.columns / 256;
+        const std::string level = core::LevelGenerator(settings).generate();
+
+        // Loading
+        suite.run("level_parse", size, "load", [&] {
+            double ns = time_ns([&] { do_not_optimize(world::parse_level(level).height); });
+            return Sample{ns, 1};
+        });
+
+        suite.run("tilemap_load", size, "load", [&] {
+            world::TileMap tilemap;
+            return Sample{time_ns([&] { tilemap.load_from_string(level, 1); }), 1};
+        });
+
+        suite.run("world_construct", size, "world", [&] {
+            std::unique_ptr<world::World> world;
+            double ns = time_ns([&] { world = std::make_unique<world::World>(level); });
+            return Sample{ns, 1};
+        });
+
+        // Same level from a compiled file: map it and build the World in place, no parsing
+        std::filesystem::path compiled_file = scratch_dir / ("level_" + std::string(size.label) + ".plvl");
+        if (world::save_compiled_level(compiled_file, world::parse_level(level).view())) {
+            suite.run("world_construct_compiled", size, "world", [&] {
+                std::unique_ptr<world::World> world;
+                double ns = time_ns([&] {
+                    auto compiled = world::CompiledLevel::open(compiled_file);
+                    if (compiled) world = std::make_unique<world::World>(compiled->view(), -1);
+                });
+                return Sample{ns, 1};
+            });
+            std::error_code ec;
+            std::filesystem::remove(compiled_file, ec);
+        } else {
+            std::cerr << "[WARNING] Cannot write " << compiled_file << ", skipping world_construct_compiled" << std::endl;
+        }
+
+        // Restart as GameState does it: tear down, reset the arena, build again
+        core::LevelArena arena;
+        std::unique_ptr<world::World> rebuilt;
+        suite.run("world_rebuild", size, "world", [&] {
+            if (!rebuilt) rebuilt = std::make_unique<world::World>(level, arena.resource());
+            double ns = time_ns([&] {
+                rebuilt.reset();
+                arena.reset();
+                rebuilt = std::make_unique<world::World>(level, arena.resource());
+            });
+            return Sample{ns, 1};
+        });
+        rebuilt.reset();
+
+        // Whole simulation step: the player runs right and hops, enemies patrol
+        suite.run("world_update", size, "tick", [&] {
+            world::World world(level);
+            const float dt = 1.0f / core::FixedTimestep::DEFAULT_TICK_RATE;
+            long long ticks = 0;
+            double ns = time_ns([&] {
+                for (; ticks < TICKS_PER_SAMPLE && !world.is_game_over() && !world.is_level_complete(); ++ticks) {
+                    entities::PlayerInput input;
+                    input.right = true;
+                    input.jump = ticks % 45 < 5;
+                    world.set_player_input(input);
+                    world.update(dt);
+                }
+            });
+            return Sample{ns, ticks};
+        });
+
+        // Collision passes, as World does them each tick
+        world::TileMap tilemap;
+        {
+            ScopedSilence silence;
+            tilemap.load_from_string(level, 1);
+        }
+
+        suite.run("collision_player", size, "query", [&] {
+            int hits = 0;
+            double ns = time_ns([&] {
+                for (int i = 0; i < QUERIES_PER_SAMPLE; ++i) {
+                    sf::FloatRect bounds = probe_bounds(i, size.columns, 48.0f);
+                    tilemap.for_each_solid_in(bounds, [&](const sf::FloatRect& tile_bounds) {
+                        if (bounds.findIntersection(tile_bounds)) hits++;
+                    });
+                }
+            });
+            do_not_optimize(hits);
+            return Sample{ns, QUERIES_PER_SAMPLE};
+        });
+
+        suite.run("collision_enemy", size, "query", [&] {
+            int hits = 0;
+            double ns = time_ns([&] {
+                for (int i = 0; i < QUERIES_PER_SAMPLE; ++i) {
+                    if (tilemap.find_solid_overlap(probe_bounds(i, size.columns, 32.0f))) hits++;
+                }
+            });
+            do_not_optimize(hits);
+            return Sample{ns, QUERIES_PER_SAMPLE};
+        });
+
+        // Render prep: baking the chunk vertex arrays for the whole level, one screen at a time
+        suite.run("render_prep", size, "chunk", [&] {
+            tilemap.invalidate_geometry();
+            sf::View camera(sf::Vector2f(400.0f, 300.0f), sf::Vector2f(800.0f, 600.0f));
+            const float level_width = static_cast<float>(tilemap.get_width()) * world::TileMap::TILE_SIZE;
+            double ns = time_ns([&] {
+                for (float x = 400.0f; x - 400.0f < level_width; x += 800.0f) {
+                    camera.setCenter(sf::Vector2f(x, 300.0f));
+                    tilemap.prepare_render(camera);
+                }
+            });
+            return Sample{ns, std::max(1, tilemap.get_chunk_count())};
+        });
+
+        // Custom level file: LEVELS_PER_FILE copies of this level
+        std::filesystem::path levels_file = scratch_dir / ("levels_" + std::string(size.label) + ".txt");
+        std::vector<core::CustomLevel> levels;
+        for (int i = 0; i < LEVELS_PER_FILE; ++i) {
+            levels.push_back(core::CustomLevel{i + 1, "Bench " + std::to_string(i + 1), level});
+        }
+        if (!core::CustomLevelManager::write_levels_file(levels_file, levels)) {
+            std::cerr << "[WARNING] Cannot write " << levels_file << ", skipping custom_levels_load" << std::endl;
+            return;
+        }
+        suite.run("custom_levels_load", size, "file", [&] {
+            std::optional<std::vector<core::CustomLevel>> loaded;
+            double ns = time_ns([&] { loaded = core::CustomLevelManager::read_levels_file(levels_file); });
+            return Sample{ns, loaded ? 1 : 0};
+        });
+        std::error_code ec;
+        std::filesystem::remove(levels_file, ec);
+
+        // Per-level storage: startup reads only the index, a save writes one level
+        std::filesystem::path levels_dir = scratch_dir / ("levels_" + std::string(size.label));
+        std::vector<core::CustomLevelInfo> index;
+        for (const auto& custom_level : levels) {
+            if (auto info = core::CustomLevelManager::write_level_data(levels_dir, custom_level)) index.push_back(*info);
+        }
+        if (index.size() != levels.size() || !core::CustomLevelManager::write_index(levels_dir, index)) {
+            std::cerr << "[WARNING] Cannot write " << levels_dir << ", skipping custom_levels_index" << std::endl;
+        } else {
+            suite.run("custom_levels_index", size, "file", [&] {
+                std::optional<std::vector<core::CustomLevelInfo>> loaded;
+                double ns = time_ns([&] { loaded = core::CustomLevelManager::read_index(levels_dir); });
+                return Sample{ns, loaded ? 1 : 0};
+            });
+            suite.run("custom_level_save", size, "level", [&] {
+                double ns = time_ns([&] {
+                    auto info = core::CustomLevelManager::write_level_data(levels_dir, levels.front());
+                    if (info) index.front() = *info;
+                    core::CustomLevelManager::write_index(levels_dir, index);
+                });
+                return Sample{ns, 1};
+            });
+        }
+        std::filesystem::remove_all(levels_dir, ec);
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--quick") {
+            options.quick = true;
+        } else if (arg == "--filter" && has_value) {
+            options.filter = argv[++i];
+        } else if (arg == "--csv" && has_value) {
+            options.csv_path = argv[++i];
+        } else if (arg == "--json" && has_value) {
+            options.json_path = argv[++i];
+        } else {
+            std::cout << "Usage: bench_suite [--quick] [--filter TEXT] [--csv PATH] [--json PATH]" << std::endl;
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    core::ResourceManager::instance().set_headless(true);
+    std::filesystem::path scratch_dir = std::filesystem::temp_directory_path();
+
+    Suite suite(options);
+    suite.print_header();
+    for (const auto& size : LEVEL_SIZES) {
+        run_level_benchmarks(suite, size, scratch_dir);
+    }
+
+    if (!options.csv_path.empty()) {
+        if (!suite.write_csv(options.csv_path)) {
+            std::cerr << "[ERROR] Failed to write " << options.csv_path << std::endl;
+            return 1;
+        }
+        std::cout << "Wrote " << options.csv_path << std::endl;
+    }
+    if (!options.json_path.empty()) {
+        if (!suite.write_json(options.json_path)) {
+            std::cerr << "[ERROR] Failed to write " << options.json_path << std::endl;
+            return 1;
+        }
+        std::cout << "Wrote " << options.json_path << std::endl;
+    }
+
+    return 0;
+}
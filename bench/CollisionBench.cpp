@@ -0,0 +1,111 @@
+// Collision query benchmark
+// Measures the per-frame cost of the player/tile collision lookup as the level grows wider.
+// The legacy path (test every solid tile) grows linearly with the level width,
+// the grid query used by World::handle_collisions should stay flat.
+//
+// Runs headless (no window, no textures): ./build/bin/collision_bench
+
+#include "world/TileMap.hpp"
+#include "core/ResourceManager.hpp"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+namespace {
+
+    constexpr int LEVEL_ROWS = 10;
+    constexpr int LEGACY_FRAMES = 200;
+    constexpr int GRID_FRAMES = 200000;
+
+    // Builds a level in the usual text format: two ground rows plus a platform every few columns
+    std::string make_level(int columns) {
+        std::string level;
+        level.reserve(static_cast<size_t>((columns + 1) * LEVEL_ROWS));
+        for (int row = 0; row < LEVEL_ROWS; ++row) {
+            for (int col = 0; col < columns; ++col) {
+                char c = ' ';
+                if (row >= LEVEL_ROWS - 2) {
+                    c = '#';
+                } else if (row == LEVEL_ROWS - 5 && (col / 4) % 3 == 0) {
+                    c = '#';
+                } else if (row == LEVEL_ROWS - 3 && col == 2) {
+                    c = 'P';
+                }
+                level += c;
+            }
+            level += '\n';
+        }
+        return level;
+    }
+
+    // Player-sized boxes spread over the whole level, so neither path benefits from a hot spot
+    sf::FloatRect probe_bounds(int frame, int columns) {
+        float x = static_cast<float>((frame * 37) % columns) * world::TileMap::TILE_SIZE + 5.0f;
+        float y = static_cast<float>(LEVEL_ROWS - 5) * world::TileMap::TILE_SIZE + 20.0f;
+        return sf::FloatRect(sf::Vector2f(x, y), sf::Vector2f(32.0f, 48.0f));
+    }
+
+    template <typename Fn>
+    double ns_per_frame(int frames, Fn&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            fn(frame);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / frames;
+    }
+
+} // namespace
+
+int main() {
+    core::ResourceManager::instance().set_headless(true);
+    const std::vector<int> widths = {100, 1000, 5000, 20000};
+
+    std::cout << std::left << std::setw(10) << "columns"
+              << std::setw(20) << "legacy ns/frame"
+              << std::setw(20) << "grid ns/frame"
+              << std::setw(20) << "enemy ns/query"
+              << "hits/frame (legacy/grid/enemy)" << std::endl;
+
+    for (int columns : widths) {
+        world::TileMap tilemap;
+        tilemap.load_from_string(make_level(columns), 1);
+
+        // Legacy: linear scan over every solid tile, as handle_collisions did before the grid query
+        int legacy_hits = 0;
+        double legacy = ns_per_frame(LEGACY_FRAMES, [&](int frame) {
+            sf::FloatRect bounds = probe_bounds(frame, columns);
+            for (const auto& tile_bounds : tilemap.get_solid_rects()) {
+                if (bounds.findIntersection(tile_bounds)) legacy_hits++;
+            }
+        });
+
+        int grid_hits = 0;
+        double grid = ns_per_frame(GRID_FRAMES, [&](int frame) {
+            sf::FloatRect bounds = probe_bounds(frame, columns);
+            tilemap.for_each_solid_in(bounds, [&](const sf::FloatRect& tile_bounds) {
+                if (bounds.findIntersection(tile_bounds)) grid_hits++;
+            });
+        });
+
+        // Enemy wall check: one early-out lookup per enemy (EnemyStore::resolve_walls)
+        int enemy_hits = 0;
+        double enemy = ns_per_frame(GRID_FRAMES, [&](int frame) {
+            sf::FloatRect bounds = probe_bounds(frame, columns);
+            bounds.size.y = 32.0f;
+            if (tilemap.find_solid_overlap(bounds)) enemy_hits++;
+        });
+
+        std::cout << std::left << std::setw(10) << columns
+                  << std::setw(20) << std::fixed << std::setprecision(1) << legacy
+                  << std::setw(20) << grid
+                  << std::setw(20) << enemy
+                  << std::setprecision(2) << static_cast<double>(legacy_hits) / LEGACY_FRAMES << "/"
+                  << static_cast<double>(grid_hits) / GRID_FRAMES << "/"
+                  << static_cast<double>(enemy_hits) / GRID_FRAMES << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include "AssetLoader.hpp"
+#include "ResourceManager.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace core {
+
+    unsigned int AssetLoader::default_worker_count() {
+        // Leave a core to the main thread; decoding a level's worth of PNGs and OGGs does
+        // not benefit from more than a few workers
+        unsigned int cores = std::thread::hardware_concurrency();
+        return std::clamp(cores > 1 ? cores - 1 : 1u, 1u, 4u);
+    }
+
+    AssetLoader::AssetLoader(unsigned int worker_count) {
+        worker_count = std::max(worker_count, 1u);
+        m_workers.reserve(worker_count);
+        for (unsigned int i = 0; i < worker_count; ++i) {
+            m_workers.emplace_back(&AssetLoader::worker_loop, this);
+        }
+    }
+
+    AssetLoader::~AssetLoader() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping = true;
+            m_jobs.clear();
+        }
+        m_wake.notify_all();
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    void AssetLoader::queue_texture(const ResourceManager& resources, const std::string& name, const std::filesystem::path& path) {
+        if (resources.has_texture(name) || resources.has_region(name)) return;
+        queue(Kind::Texture, name, path);
+    }
+
+    void AssetLoader::queue_sound(const ResourceManager& resources, const std::string& name, const std::filesystem::path& path) {
+        if (resources.has_sound_buffer(name)) return;
+        queue(Kind::Sound, name, path);
+    }
+
+    void AssetLoader::queue_sounds(const ResourceManager& resources, std::span<const SoundAsset> sounds) {
+        for (const auto& sound : sounds) {
+            queue_sound(resources, std::string(sound.name.text), sound.path);
+        }
+    }
+
+    void AssetLoader::queue(Kind kind, const std::string& name, const std::filesystem::path& path) {
+        {
+            std::lock_guard lock(m_mutex);
+            m_jobs.push_back({kind, name, path});
+        }
+        m_total++;
+        m_wake.notify_one();
+    }
+
+    void AssetLoader::worker_loop() {
+        while (true) {
+            Job job;
+            {
+                std::unique_lock lock(m_mutex);
+                m_wake.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+                if (m_stopping) return;
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+
+            // File IO and decoding, the slow part, happen without the lock
+            Decoded decoded;
+            decoded.job = std::move(job);
+            if (decoded.job.kind == Kind::Texture) {
+                decoded.ok = decoded.image.loadFromFile(decoded.job.path);
+            } else {
+                decoded.ok = decoded.sound.loadFromFile(decoded.job.path);
+            }
+
+            std::lock_guard lock(m_mutex);
+            m_decoded.push_back(std::move(decoded));
+        }
+    }
+
+    void AssetLoader::poll(ResourceManager& resources, int max_uploads) {
+        std::deque<Decoded> ready;
+        {
+            std::lock_guard lock(m_mutex);
+            // Sounds need no upload, take them all; textures only up to the budget
+            int uploads = 0;
+            for (auto it = m_decoded.begin(); it != m_decoded.end();) {
+                if (it->job.kind == Kind::Texture && uploads >= max_uploads) {
+                    ++it;
+                    continue;
+                }
+                if (it->job.kind == Kind::Texture) uploads++;
+                ready.push_back(std::move(*it));
+                it = m_decoded.erase(it);
+            }
+        }
+
+        for (auto& decoded : ready) {
+            if (decoded.job.kind == Kind::Texture) {
+                if (!decoded.ok) {
+                    std::cerr << "[WARNING] Failed to load texture: " << decoded.job.path << ". Using fallback." << std::endl;
+                }
+                resources.add_texture(decoded.job.name, decoded.ok ? &decoded.image : nullptr);
+            } else {
+                if (!decoded.ok) {
+                    std::cerr << "[ERROR] Failed to load sound buffer: " << decoded.job.path << std::endl;
+                }
+                resources.add_sound_buffer(decoded.job.name, std::move(decoded.sound));
+            }
+            m_completed++;
+        }
+    }
+
+} // namespace core
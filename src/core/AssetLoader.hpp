@@ -0,0 +1,82 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include "SoundManifest.hpp"
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace core {
+
+    class ResourceManager;
+
+    // Background asset loading. Images and sounds are read and decoded on worker threads;
+    // poll() hands finished ones to ResourceManager on the calling (main) thread, which is
+    // where texture uploads must happen. Poll once per frame and draw a progress screen
+    // until is_done(), so loading never freezes the window.
+    class AssetLoader {
+    public:
+        explicit AssetLoader(unsigned int worker_count = default_worker_count());
+        ~AssetLoader(); // Abandons queued work and joins the workers
+
+        AssetLoader(const AssetLoader&) = delete;
+        AssetLoader& operator=(const AssetLoader&) = delete;
+
+        // Names already loaded in `resources` are skipped
+        void queue_texture(const ResourceManager& resources, const std::string& name, const std::filesystem::path& path);
+        void queue_sound(const ResourceManager& resources, const std::string& name, const std::filesystem::path& path);
+        void queue_sounds(const ResourceManager& resources, std::span<const SoundAsset> sounds);
+
+        // Publishes decoded assets, uploading at most `max_uploads` textures so a frame
+        // never waits on more than a few uploads
+        void poll(ResourceManager& resources, int max_uploads = UPLOADS_PER_POLL);
+
+        [[nodiscard]] size_t get_total() const { return m_total; }
+        [[nodiscard]] size_t get_completed() const { return m_completed; }
+        [[nodiscard]] float get_progress() const {
+            return m_total == 0 ? 1.0f : static_cast<float>(m_completed) / static_cast<float>(m_total);
+        }
+        [[nodiscard]] bool is_done() const { return m_completed == m_total; }
+
+        static unsigned int default_worker_count();
+
+        static constexpr int UPLOADS_PER_POLL = 4;
+
+    private:
+        enum class Kind { Texture, Sound };
+
+        struct Job {
+            Kind kind;
+            std::string name;
+            std::filesystem::path path;
+        };
+
+        struct Decoded {
+            Job job;
+            bool ok = false;
+            sf::Image image;
+            sf::SoundBuffer sound;
+        };
+
+        void queue(Kind kind, const std::string& name, const std::filesystem::path& path);
+        void worker_loop();
+
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::deque<Job> m_jobs;          // Waiting for a worker
+        std::deque<Decoded> m_decoded;   // Waiting for poll()
+        bool m_stopping = false;
+        std::vector<std::thread> m_workers;
+
+        // Main thread only
+        size_t m_total = 0;
+        size_t m_completed = 0;
+    };
+
+} // namespace core
@@ -0,0 +1,39 @@
+#include "AtlasManifest.hpp"
+#include "ResourceManager.hpp"
+#include "SkinManager.hpp"
+#include <string>
+
+namespace core {
+
+    void register_atlas_sprites(ResourceManager& resources) {
+        const std::string tiles = "assets/Pack_to_pick/Game/Sprites/Tiles/Default/";
+        const std::string enemies = "assets/Pack_to_pick/Game/Sprites/Enemies/Default/";
+        const std::string characters = "assets/Pack_to_pick/Game/Sprites/Characters/Default/";
+
+        // Tiles
+        resources.register_atlas_image("grass_tile", "assets/gameplay/tiles/terrain_grass_block.png");
+        resources.register_atlas_image("checkpoint", tiles + "switch_red.png");
+        resources.register_atlas_image("checkpoint_active", tiles + "switch_red_pressed.png");
+        resources.register_atlas_image("flag_yellow", tiles + "flag_yellow_a.png");
+
+        // Enemies and items
+        resources.register_atlas_image("slime_walk_a", enemies + "slime_normal_walk_a.png");
+        resources.register_atlas_image("slime_walk_b", enemies + "slime_normal_walk_b.png");
+        resources.register_atlas_image("fly_a", enemies + "fly_a.png");
+        resources.register_atlas_image("fly_b", enemies + "fly_b.png");
+        resources.register_atlas_image("coin_gold", "assets/gameplay/items/coin_gold.png");
+
+        // Player animations for every skin
+        for (const auto& skin : SkinManager::instance().get_all_skins()) {
+            const std::string& prefix = skin.texture_prefix;
+            for (const char* frame : {"_idle", "_jump", "_walk_a", "_walk_b"}) {
+                resources.register_atlas_image("player_" + prefix + frame, characters + prefix + frame + ".png");
+            }
+        }
+
+        // HUD
+        resources.register_atlas_image("life_full", tiles + "hud_heart.png");
+        resources.register_atlas_image("life_empty", tiles + "hud_heart_empty.png");
+    }
+
+} // namespace core
@@ -0,0 +1,12 @@
+#pragma once
+
+namespace core {
+
+    class ResourceManager;
+
+    // Registers the Pack_to_pick sprites drawn during gameplay (tiles, entities, HUD) for
+    // atlas packing. Names match the keys the tilemap and entities look up, so they get
+    // the packed region instead of a standalone texture.
+    void register_atlas_sprites(ResourceManager& resources);
+
+} // namespace core
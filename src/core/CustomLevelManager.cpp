@@ -1,9 +1,20 @@
 #include "CustomLevelManager.hpp"
+#include "../world/CompiledLevel.hpp"
+#include "../world/LevelParser.hpp"
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <algorithm>
 #include <filesystem>
+#include <chrono>
+#include <iterator>
+#include <string_view>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PLATFORMER_HAS_FSYNC 1
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace core {
 
@@ -12,19 +23,216 @@ namespace core {
         return instance;
     }
 
+    namespace {
+        constexpr const char* INDEX_FILE = "index.txt";
+
+        std::filesystem::path level_file(const std::filesystem::path& dir, int id) {
+            return dir / ("level_" + std::to_string(id) + ".txt");
+        }
+
+#ifdef PLATFORMER_HAS_FSYNC
+        bool write_and_sync(const std::filesystem::path& path, std::string_view contents) {
+            int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0) return false;
+            size_t written = 0;
+            while (written < contents.size()) {
+                ssize_t result = ::write(fd, contents.data() + written, contents.size() - written);
+                if (result <= 0) {
+                    ::close(fd);
+                    return false;
+                }
+                written += static_cast<size_t>(result);
+            }
+            bool synced = ::fsync(fd) == 0;
+            return ::close(fd) == 0 && synced;
+        }
+
+        void sync_directory(const std::filesystem::path& dir) {
+            int fd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY);
+            if (fd < 0) return;
+            ::fsync(fd);
+            ::close(fd);
+        }
+#endif
+
+        // Writes next to `path` and renames over it; the rename replaces the old file in
+        // one step, so readers see either the old contents or the new ones. On POSIX the
+        // data is synced before the rename and the directory after it, so a power loss
+        // cannot leave the new name pointing at unwritten data; elsewhere the write is only
+        // flushed, which protects against crashes of the game but not of the system.
+        bool write_file_atomic(const std::filesystem::path& path, std::string_view contents) {
+            std::filesystem::path temp = path;
+            temp += ".tmp";
+#ifdef PLATFORMER_HAS_FSYNC
+            if (!write_and_sync(temp, contents)) {
+                std::error_code ignored;
+                std::filesystem::remove(temp, ignored);
+                return false;
+            }
+#else
+            {
+                std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+                if (!file.is_open()) return false;
+                file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+                file.flush();
+                if (!file) return false;
+            }
+#endif
+            std::error_code error;
+            std::filesystem::rename(temp, path, error);
+            if (error) {
+                std::filesystem::remove(temp, error);
+                return false;
+            }
+#ifdef PLATFORMER_HAS_FSYNC
+            sync_directory(path.parent_path());
+#endif
+            return true;
+        }
+    }
+
     CustomLevelManager::CustomLevelManager() {
-        load_from_file();
+        load_index();
     }
 
-    void CustomLevelManager::load_from_file() {
+    void CustomLevelManager::load_index() {
         m_levels.clear();
+        m_unmigrated.clear();
         
-        std::ifstream file(SAVE_FILE);
-        if (!file.is_open()) {
+        auto levels = read_index(SAVE_DIR);
+        if (!levels) {
+            migrate_legacy_file();
+            return;
+        }
+        m_levels = std::move(*levels);
+
+        std::cout << "Loaded index of " << m_levels.size() << " custom levels." << std::endl;
+    }
+
+    void CustomLevelManager::save_index() {
+        if (!m_unmigrated.empty() && !retry_migration()) {
+            // Without an index the next start migrates from the old file again
+            std::cerr << m_unmigrated.size() << " custom levels are not migrated yet; "
+                      << "the index is not written until they are." << std::endl;
+            return;
+        }
+        if (!write_index(SAVE_DIR, m_levels)) {
+            std::cerr << "Failed to save custom level index!" << std::endl;
+        }
+    }
+
+    void CustomLevelManager::migrate_legacy_file() {
+        auto levels = read_levels_file(LEGACY_SAVE_FILE);
+        if (!levels) {
             std::cout << "No custom levels file found, starting fresh." << std::endl;
             return;
         }
 
+        // One-time split of the old single file; it is left in place as a backup
+        for (const auto& level : *levels) {
+            auto info = write_level_data(SAVE_DIR, level);
+            if (!info) {
+                std::cerr << "Failed to migrate custom level " << level.id << "!" << std::endl;
+                m_unmigrated.push_back(level);
+                continue;
+            }
+            m_levels.push_back(std::move(*info));
+        }
+        // Writing the index ends the migration, so it waits until every level made it
+        save_index();
+
+        std::cout << "Migrated " << m_levels.size() << " custom levels to " << SAVE_DIR << "/." << std::endl;
+    }
+
+    bool CustomLevelManager::retry_migration() {
+        std::erase_if(m_unmigrated, [this](const CustomLevel& level) {
+            auto info = write_level_data(SAVE_DIR, level);
+            if (!info) return false;
+            m_levels.push_back(std::move(*info));
+            return true;
+        });
+        return m_unmigrated.empty();
+    }
+
+    std::optional<std::vector<CustomLevelInfo>> CustomLevelManager::read_index(const std::filesystem::path& dir) {
+        std::ifstream file(dir / INDEX_FILE);
+        if (!file.is_open()) {
+            return std::nullopt;
+        }
+
+        // One level per line: id, size, modified and name, tab separated (name last, so
+        // it may contain anything but a newline)
+        std::vector<CustomLevelInfo> levels;
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream fields(line);
+            CustomLevelInfo info;
+            if (!(fields >> info.id >> info.size >> info.modified)) continue;
+            fields.ignore(1); // Tab before the name
+            std::getline(fields, info.name);
+            levels.push_back(std::move(info));
+        }
+
+        return levels;
+    }
+
+    bool CustomLevelManager::write_index(const std::filesystem::path& dir, const std::vector<CustomLevelInfo>& levels) {
+        std::error_code error;
+        std::filesystem::create_directories(dir, error);
+
+        std::ostringstream contents;
+        for (const auto& level : levels) {
+            contents << level.id << '\t' << level.size << '\t' << level.modified << '\t' << level.name << '\n';
+        }
+        return write_file_atomic(dir / INDEX_FILE, contents.str());
+    }
+
+    std::filesystem::path CustomLevelManager::compiled_level_file(const std::filesystem::path& dir, int id) {
+        return dir / ("level_" + std::to_string(id) + ".plvl");
+    }
+
+    std::optional<std::string> CustomLevelManager::read_level_data(const std::filesystem::path& dir, int id) {
+        std::ifstream file(level_file(dir, id), std::ios::binary);
+        if (!file.is_open()) {
+            return std::nullopt;
+        }
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    std::optional<CustomLevelInfo> CustomLevelManager::write_level_data(const std::filesystem::path& dir, const CustomLevel& level) {
+        std::error_code error;
+        std::filesystem::create_directories(dir, error);
+        // The game prefers the compiled copy, so the old one goes first: if the new one is
+        // never written (failure or crash) the level plays from the new text, not stale data
+        std::filesystem::path compiled_path = compiled_level_file(dir, level.id);
+        std::filesystem::remove(compiled_path, error);
+        if (error) {
+            std::cerr << "[ERROR] Cannot replace compiled custom level " << level.id << ": " << error.message() << std::endl;
+            return std::nullopt;
+        }
+        if (!write_file_atomic(level_file(dir, level.id), level.data)) {
+            return std::nullopt;
+        }
+        // Compiled copy for playing (mapped, never parsed); the text stays for the editor.
+        // Without it the game falls back to the text, so a failure here is not fatal.
+        std::vector<std::byte> compiled = world::compile_level(world::parse_level(level.data).view());
+        if (!write_file_atomic(compiled_path,
+                               std::string_view(reinterpret_cast<const char*>(compiled.data()), compiled.size()))) {
+            std::cerr << "[WARNING] Cannot write compiled custom level " << level.id << std::endl;
+        }
+
+        auto now = std::chrono::system_clock::now().time_since_epoch();
+        return CustomLevelInfo{level.id, level.name, level.data.size(),
+                               std::chrono::duration_cast<std::chrono::seconds>(now).count()};
+    }
+
+    std::optional<std::vector<CustomLevel>> CustomLevelManager::read_levels_file(const std::filesystem::path& path) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            return std::nullopt;
+        }
+
+        std::vector<CustomLevel> levels;
         std::string line;
         CustomLevel current;
         bool in_level = false;
@@ -44,7 +252,7 @@ namespace core {
             } else if (line.find("DATA_END") == 0 && in_level) {
                 current.data = data_buffer;
             } else if (line.find("LEVEL_END") == 0 && in_level) {
-                m_levels.push_back(current);
+                levels.push_back(current);
                 in_level = false;
             } else if (in_level && line.find("NAME:") != 0 && line.find("DATA_START") != 0) {
                 // Part of level data
@@ -53,17 +261,16 @@ namespace core {
             }
         }
 
-        std::cout << "Loaded " << m_levels.size() << " custom levels." << std::endl;
+        return levels;
     }
 
-    void CustomLevelManager::save_to_file() {
-        std::ofstream file(SAVE_FILE);
+    bool CustomLevelManager::write_levels_file(const std::filesystem::path& path, const std::vector<CustomLevel>& levels) {
+        std::ofstream file(path);
         if (!file.is_open()) {
-            std::cerr << "Failed to save custom levels!" << std::endl;
-            return;
+            return false;
         }
 
-        for (const auto& level : m_levels) {
+        for (const auto& level : levels) {
             file << "LEVEL_START:" << level.id << "\n";
             file << "NAME:" << level.name << "\n";
             file << "DATA_START\n";
@@ -71,36 +278,68 @@ namespace core {
             file << "DATA_END\n";
             file << "LEVEL_END\n";
         }
-
-        std::cout << "Saved " << m_levels.size() << " custom levels." << std::endl;
+        return static_cast<bool>(file);
     }
 
     void CustomLevelManager::save_level(const CustomLevel& level) {
+        // Only this level's file and the index are written
+        auto info = write_level_data(SAVE_DIR, level);
+        if (!info) {
+            std::cerr << "Failed to save custom level " << level.id << "!" << std::endl;
+            return;
+        }
+
         // Update existing or add new
         auto it = std::find_if(m_levels.begin(), m_levels.end(),
-            [&level](const CustomLevel& l) { return l.id == level.id; });
+            [&level](const CustomLevelInfo& l) { return l.id == level.id; });
         
         if (it != m_levels.end()) {
-            *it = level;
+            *it = std::move(*info);
         } else {
-            m_levels.push_back(level);
+            m_levels.push_back(std::move(*info));
         }
         
-        save_to_file();
+        save_index();
+    }
+
+    int CustomLevelManager::add_generated_level(const LevelGeneratorSettings& settings) {
+        CustomLevel level;
+        level.id = get_next_id();
+        level.name = "Generated " + std::to_string(settings.width) + "x" + std::to_string(settings.height) +
+                     " #" + std::to_string(settings.seed);
+        level.data = LevelGenerator(settings).generate();
+        save_level(level);
+        return level.id;
     }
 
     void CustomLevelManager::delete_level(int id) {
         m_levels.erase(
             std::remove_if(m_levels.begin(), m_levels.end(),
-                [id](const CustomLevel& l) { return l.id == id; }),
+                [id](const CustomLevelInfo& l) { return l.id == id; }),
             m_levels.end()
         );
-        save_to_file();
+        // Index first: a crash in between leaves an unreferenced file, not a dangling entry
+        save_index();
+        std::error_code error;
+        std::filesystem::remove(level_file(SAVE_DIR, id), error);
+        std::filesystem::remove(compiled_level_file(SAVE_DIR, id), error);
     }
 
     std::optional<CustomLevel> CustomLevelManager::get_level(int id) const {
+        auto info = get_level_info(id);
+        if (!info) return std::nullopt;
+        
+        auto data = read_level_data(SAVE_DIR, id);
+        if (!data) {
+            std::cerr << "[ERROR] Missing data for custom level " << id << std::endl;
+            return std::nullopt;
+        }
+        return CustomLevel{info->id, info->name, std::move(*data)};
+    }
+
+    std::optional<CustomLevelInfo> CustomLevelManager::get_level_info(int id) const {
         auto it = std::find_if(m_levels.begin(), m_levels.end(),
-            [id](const CustomLevel& l) { return l.id == id; });
+            [id](const CustomLevelInfo& l) { return l.id == id; });
         
         if (it != m_levels.end()) {
             return *it;
@@ -113,11 +352,14 @@ namespace core {
         for (const auto& level : m_levels) {
             max_id = std::max(max_id, level.id);
         }
+        for (const auto& level : m_unmigrated) {
+            max_id = std::max(max_id, level.id);
+        }
         return max_id + 1;
     }
 
     void CustomLevelManager::reload() {
-        load_from_file();
+        load_index();
     }
 
 } // namespace core
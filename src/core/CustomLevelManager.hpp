@@ -3,6 +3,9 @@
 #include <string>
 #include <vector>
 #include <optional>
+#include <filesystem>
+#include <cstdint>
+#include "LevelGenerator.hpp"
 
 namespace core {
 
@@ -12,29 +15,69 @@ namespace core {
         std::string data;  // Level data in string format (like World::get_level_data)
     };
 
+    // Index entry of a saved level; the body stays on disk until get_level() asks for it
+    struct CustomLevelInfo {
+        int id = 0;
+        std::string name;
+        std::uintmax_t size = 0;   // Bytes of level data
+        std::int64_t modified = 0; // Seconds since the Unix epoch of the last save
+    };
+
+    // Custom levels live in SAVE_DIR, one text file per level (for the editor) with a
+    // compiled copy next to it (see world::CompiledLevel, for playing) plus a small index of
+    // their metadata. Startup only reads the index; saving or deleting a level rewrites that
+    // level's files and the index, each written to a temporary file first and renamed over
+    // the old one (synced to disk first on POSIX), so a crash never leaves a half-written
+    // level behind.
     class CustomLevelManager {
     public:
         static CustomLevelManager& instance();
 
         // CRUD operations
         void save_level(const CustomLevel& level);
+        // Generates a level (see LevelGenerator), saves it as a new custom level and returns its id
+        int add_generated_level(const LevelGeneratorSettings& settings);
         void delete_level(int id);
+        // Reads the level's body from disk
         std::optional<CustomLevel> get_level(int id) const;
-        const std::vector<CustomLevel>& get_all_levels() const { return m_levels; }
+        std::optional<CustomLevelInfo> get_level_info(int id) const;
+        // Compiled copy of the level, written on every save; may be missing for levels saved
+        // by older versions, in which case get_level() has the text
+        [[nodiscard]] std::filesystem::path get_compiled_path(int id) const { return compiled_level_file(SAVE_DIR, id); }
+        const std::vector<CustomLevelInfo>& get_all_levels() const { return m_levels; }
         
         // Utility
         int get_next_id() const;
         void reload();
+        
+        // Storage helpers, independent of the singleton's own directory (tools, benchmarks).
+        // read_index returns nullopt when the directory has no index.
+        static std::optional<std::vector<CustomLevelInfo>> read_index(const std::filesystem::path& dir);
+        static bool write_index(const std::filesystem::path& dir, const std::vector<CustomLevelInfo>& levels);
+        static std::optional<std::string> read_level_data(const std::filesystem::path& dir, int id);
+        [[nodiscard]] static std::filesystem::path compiled_level_file(const std::filesystem::path& dir, int id);
+        // Writes the level's text and compiled files and returns its index entry (nullopt on failure)
+        static std::optional<CustomLevelInfo> write_level_data(const std::filesystem::path& dir, const CustomLevel& level);
+
+        // Single-file format used before SAVE_DIR; still read once to migrate old saves.
+        // read_levels_file returns nullopt when the file cannot be opened.
+        static std::optional<std::vector<CustomLevel>> read_levels_file(const std::filesystem::path& path);
+        static bool write_levels_file(const std::filesystem::path& path, const std::vector<CustomLevel>& levels);
 
     private:
         CustomLevelManager();
         ~CustomLevelManager() = default;
         
-        void load_from_file();
-        void save_to_file();
+        void load_index();
+        void save_index();
+        void migrate_legacy_file();
+        bool retry_migration(); // True once every legacy level is in SAVE_DIR
         
-        std::vector<CustomLevel> m_levels;
-        static constexpr const char* SAVE_FILE = "custom_levels.json";
+        std::vector<CustomLevelInfo> m_levels;
+        // Legacy levels whose migration failed; the index is held back until they are written
+        std::vector<CustomLevel> m_unmigrated;
+        static constexpr const char* SAVE_DIR = "custom_levels";
+        static constexpr const char* LEGACY_SAVE_FILE = "custom_levels.json";
     };
 
 } // namespace core
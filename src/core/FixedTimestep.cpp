@@ -0,0 +1,36 @@
+#include "FixedTimestep.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace core {
+
+    FixedTimestep::FixedTimestep(float tick_rate, int max_steps)
+        : m_step(1.0f / DEFAULT_TICK_RATE), m_max_steps(std::max(1, max_steps)) {
+        set_tick_rate(tick_rate);
+    }
+
+    void FixedTimestep::set_tick_rate(float tick_rate) {
+        if (tick_rate <= 0.0f) {
+            std::cerr << "[WARNING] Invalid tick rate " << tick_rate << ", using " << DEFAULT_TICK_RATE << " Hz" << std::endl;
+            tick_rate = DEFAULT_TICK_RATE;
+        }
+        m_step = 1.0f / tick_rate;
+        m_accumulator = 0.0f;
+    }
+
+    int FixedTimestep::advance(float frame_seconds) {
+        m_accumulator += std::max(0.0f, frame_seconds);
+        
+        int steps = static_cast<int>(m_accumulator / m_step);
+        if (steps > m_max_steps) {
+            // After a hitch (window drag, loading) drop the backlog instead of spiralling:
+            // the game slows down for that frame rather than freezing to catch up
+            steps = m_max_steps;
+            m_accumulator = 0.0f;
+        } else {
+            m_accumulator = std::max(0.0f, m_accumulator - steps * m_step);
+        }
+        return steps;
+    }
+
+} // namespace core
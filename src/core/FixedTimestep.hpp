@@ -0,0 +1,30 @@
+#pragma once
+
+namespace core {
+
+    // Accumulator for a fixed-rate simulation. Each frame the real elapsed time is fed in
+    // and the caller runs the returned number of steps of get_step() seconds, so physics
+    // behaves the same at any frame rate. get_alpha() is how far the leftover time reaches
+    // into the next step, used to interpolate rendering between the last two states.
+    class FixedTimestep {
+    public:
+        explicit FixedTimestep(float tick_rate = DEFAULT_TICK_RATE, int max_steps = DEFAULT_MAX_STEPS);
+
+        // Adds a frame's elapsed time and returns how many steps to simulate now
+        int advance(float frame_seconds);
+
+        void set_tick_rate(float tick_rate);
+        [[nodiscard]] float get_tick_rate() const { return 1.0f / m_step; }
+        [[nodiscard]] float get_step() const { return m_step; }
+        [[nodiscard]] float get_alpha() const { return m_accumulator / m_step; }
+
+        static constexpr float DEFAULT_TICK_RATE = 120.0f;
+        static constexpr int DEFAULT_MAX_STEPS = 8;
+
+    private:
+        float m_step;
+        float m_accumulator = 0.0f;
+        int m_max_steps;
+    };
+
+} // namespace core
@@ -21,14 +21,17 @@ namespace core {
 
     void GameWindow::clear(sf::Color color) {
         m_window.clear(color);
+        m_frame_draw_calls = 0;
     }
 
     void GameWindow::display() {
         m_window.display();
+        m_last_frame_draw_calls = m_frame_draw_calls;
     }
 
-    void GameWindow::draw(const sf::Drawable& drawable) {
-        m_window.draw(drawable);
+    void GameWindow::draw(const sf::Drawable& drawable, const sf::RenderStates& states) {
+        m_window.draw(drawable, states);
+        m_frame_draw_calls++;
     }
 
     sf::RenderWindow& GameWindow::get_sf_window() {
@@ -13,12 +13,17 @@ namespace core {
         void poll_events();
         void clear(sf::Color color = sf::Color::Black);
         void display();
-        void draw(const sf::Drawable& drawable);
+        void draw(const sf::Drawable& drawable, const sf::RenderStates& states = sf::RenderStates::Default);
+        
+        // Draw calls issued during the last presented frame (counted from clear() to display())
+        [[nodiscard]] unsigned int get_draw_calls() const { return m_last_frame_draw_calls; }
         
         [[nodiscard]] sf::RenderWindow& get_sf_window();
 
     private:
         sf::RenderWindow m_window;
+        unsigned int m_frame_draw_calls = 0;
+        unsigned int m_last_frame_draw_calls = 0;
     };
 
 } // namespace core
@@ -0,0 +1,38 @@
+#include "LevelArena.hpp"
+#include <iostream>
+
+namespace core {
+
+    void* LevelArena::OverflowResource::do_allocate(size_t bytes, size_t alignment) {
+        m_allocated += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void LevelArena::OverflowResource::do_deallocate(void* p, size_t bytes, size_t alignment) {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    LevelArena::LevelArena(size_t capacity)
+        : m_block(std::make_unique_for_overwrite<std::byte[]>(capacity)),
+          m_capacity(capacity) {
+        m_resource.emplace(m_block.get(), m_capacity, &m_overflow);
+    }
+
+    void LevelArena::reset() {
+        // Hands the overflow chunks back to the heap and rewinds to the start of the block
+        m_resource->release();
+
+        size_t overflow = m_overflow.get_allocated();
+        if (overflow > 0) {
+            // The monotonic resource grows its overflow chunks geometrically, so their sum
+            // is a comfortable upper bound for what the level needed beyond the block
+            m_resource.reset();
+            m_capacity += overflow;
+            m_block = std::make_unique_for_overwrite<std::byte[]>(m_capacity);
+            std::cout << "Level arena grown to " << m_capacity / 1024 << " KiB" << std::endl;
+        }
+        m_overflow.clear_tally();
+        m_resource.emplace(m_block.get(), m_capacity, &m_overflow);
+    }
+
+} // namespace core
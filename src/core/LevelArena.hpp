@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+namespace core {
+
+    // Memory for everything a World allocates while it lives (entity stores, spawn tables,
+    // tile grid). Allocations are bump-pointer from one block and nothing is freed
+    // individually; reset() drops the whole level at once so the next one reuses the block.
+    // When a level outgrows the block the excess comes from the heap, and the next reset()
+    // enlarges the block to cover it, so repeated restarts of the same level settle at zero
+    // heap allocations.
+    //
+    // Whatever was allocated from resource() must be destroyed before reset().
+    class LevelArena {
+    public:
+        explicit LevelArena(size_t capacity = DEFAULT_CAPACITY);
+
+        LevelArena(const LevelArena&) = delete;
+        LevelArena& operator=(const LevelArena&) = delete;
+
+        [[nodiscard]] std::pmr::memory_resource* resource() { return &*m_resource; }
+        void reset();
+
+        [[nodiscard]] size_t get_capacity() const { return m_capacity; }
+        // Bytes taken from the heap since the last reset because the block was full
+        [[nodiscard]] size_t get_overflow_bytes() const { return m_overflow.get_allocated(); }
+
+        static constexpr size_t DEFAULT_CAPACITY = 256 * 1024;
+
+    private:
+        // Forwards to the heap and keeps a tally, so reset() knows how far to grow
+        class OverflowResource : public std::pmr::memory_resource {
+        public:
+            [[nodiscard]] size_t get_allocated() const { return m_allocated; }
+            void clear_tally() { m_allocated = 0; }
+
+        private:
+            void* do_allocate(size_t bytes, size_t alignment) override;
+            void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+            size_t m_allocated = 0;
+        };
+
+        std::unique_ptr<std::byte[]> m_block;
+        size_t m_capacity;
+        OverflowResource m_overflow;
+        std::optional<std::pmr::monotonic_buffer_resource> m_resource;
+    };
+
+} // namespace core
@@ -0,0 +1,160 @@
+#include "LevelGenerator.hpp"
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace core {
+
+    namespace {
+        // std::mt19937 produces the same sequence everywhere, the standard distributions
+        // do not; bounded draws are done by hand to keep levels identical across compilers
+        class Random {
+        public:
+            explicit Random(std::uint32_t seed) : m_engine(seed) {}
+
+            int below(int bound) {
+                return bound <= 0 ? 0 : static_cast<int>(m_engine() % static_cast<std::uint32_t>(bound));
+            }
+
+            bool chance(float probability) {
+                return static_cast<float>(m_engine()) / 4294967296.0f < probability;
+            }
+
+            // Moves `count` random elements to the front (partial Fisher-Yates)
+            template <typename T>
+            void pick_front(std::vector<T>& items, size_t count) {
+                count = std::min(count, items.size());
+                for (size_t i = 0; i < count; ++i) {
+                    size_t j = i + static_cast<size_t>(below(static_cast<int>(items.size() - i)));
+                    std::swap(items[i], items[j]);
+                }
+            }
+
+        private:
+            std::mt19937 m_engine;
+        };
+
+        struct Cell {
+            int col;
+            int row;
+        };
+    }
+
+    LevelGenerator::LevelGenerator(const LevelGeneratorSettings& settings) : m_settings(settings) {
+        if (m_settings.width < MIN_WIDTH || m_settings.height < MIN_HEIGHT) {
+            std::cerr << "[WARNING] Generated level too small (" << m_settings.width << "x" << m_settings.height
+                      << "), clamping to " << MIN_WIDTH << "x" << MIN_HEIGHT << std::endl;
+            m_settings.width = std::max(m_settings.width, MIN_WIDTH);
+            m_settings.height = std::max(m_settings.height, MIN_HEIGHT);
+        }
+    }
+
+    std::string LevelGenerator::generate() const {
+        const int width = m_settings.width;
+        const int height = m_settings.height;
+        const int ground_top = height - 2;     // First of the two ground rows
+        const int safe_margin = 8;             // Columns near the spawn and flag stay plain ground
+        Random random(m_settings.seed);
+
+        std::vector<std::string> rows(height, std::string(width, ' '));
+        auto at = [&rows](int col, int row) -> char& { return rows[row][col]; };
+
+        // Ground with the occasional 2-3 tile gap
+        for (int col = 0; col < width; ++col) {
+            at(col, ground_top) = '#';
+            at(col, ground_top + 1) = '#';
+        }
+        for (int col = safe_margin; col < width - safe_margin; ++col) {
+            if (random.chance(m_settings.gap_density)) {
+                int gap = 2 + random.below(2);
+                for (int i = 0; i < gap && col + i < width - safe_margin; ++i) {
+                    at(col + i, ground_top) = ' ';
+                    at(col + i, ground_top + 1) = ' ';
+                }
+                col += gap + 2; // Always leave ground to land on between gaps
+            }
+        }
+
+        // Platforms one jump (3 tiles) above the ground, or one more jump above that
+        for (int col = safe_margin; col < width - safe_margin; ++col) {
+            if (random.chance(m_settings.platform_density)) {
+                int length = 3 + random.below(4);
+                int row = ground_top - 3;
+                if (ground_top - 6 >= 1 && random.chance(0.3f)) row = ground_top - 6;
+                for (int i = 0; i < length && col + i < width - 1; ++i) {
+                    at(col + i, row) = '#';
+                }
+                col += length;
+            }
+        }
+
+        // Border walls keep the player inside the level
+        for (int row = 0; row < height; ++row) {
+            at(0, row) = '#';
+            at(width - 1, row) = '#';
+        }
+
+        at(2, ground_top - 1) = 'P';
+        at(width - 3, ground_top - 1) = 'F';
+
+        // Checkpoints evenly spaced along the ground
+        const int checkpoints = std::max(0, m_settings.checkpoint_count);
+        for (int i = 1; i <= checkpoints; ++i) {
+            int col = static_cast<int>(static_cast<long long>(width) * i / (checkpoints + 1));
+            for (; col < width - safe_margin; ++col) {
+                if (at(col, ground_top) == '#' && at(col, ground_top - 1) == ' ') {
+                    at(col, ground_top - 1) = 'C';
+                    break;
+                }
+            }
+        }
+
+        // Walking enemies stand on solid tiles, flyers and coins float in open air
+        std::vector<Cell> standing;
+        std::vector<Cell> air;
+        for (int row = 1; row < ground_top; ++row) {
+            for (int col = safe_margin; col < width - 3; ++col) {
+                if (at(col, row) != ' ') continue;
+                if (at(col, row + 1) == '#') {
+                    standing.push_back({col, row});
+                } else if (row < ground_top - 1) {
+                    air.push_back({col, row});
+                }
+            }
+        }
+
+        // Takes up to `count` random free cells from `cells` for `tile`
+        auto place = [&](std::vector<Cell>& cells, int count, char tile) {
+            random.pick_front(cells, static_cast<size_t>(std::max(0, count)));
+            int placed = 0;
+            for (size_t i = 0; i < cells.size() && placed < count; ++i) {
+                char& cell = at(cells[i].col, cells[i].row);
+                if (cell != ' ') continue;
+                cell = tile;
+                placed++;
+            }
+            if (placed < count) {
+                std::cerr << "[WARNING] Level generator placed " << placed << " of " << count
+                          << " '" << tile << "' (no free cells left)" << std::endl;
+            }
+        };
+        place(standing, m_settings.enemy_count, 'E');
+        place(air, m_settings.flying_enemy_count, 'V');
+        // Coins go anywhere still free, on the ground or in the air
+        std::vector<Cell> free_cells;
+        free_cells.reserve(standing.size() + air.size());
+        for (const auto& cell : standing) if (at(cell.col, cell.row) == ' ') free_cells.push_back(cell);
+        for (const auto& cell : air) if (at(cell.col, cell.row) == ' ') free_cells.push_back(cell);
+        place(free_cells, m_settings.coin_count, 'O');
+
+        std::string level;
+        level.reserve(static_cast<size_t>(width + 1) * height);
+        for (const auto& row : rows) {
+            level += row;
+            level += '\n';
+        }
+        return level;
+    }
+
+} // namespace core
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace core {
+
+    // Tunables for LevelGenerator. Densities are the chance per column of starting a
+    // feature there; counts are capped by the free cells the level actually has.
+    struct LevelGeneratorSettings {
+        std::uint32_t seed = 1;
+        int width = 200;            // Columns, including the border walls
+        int height = 12;            // Rows, including the two ground rows
+        float platform_density = 0.08f;
+        float gap_density = 0.03f;
+        int enemy_count = 10;
+        int flying_enemy_count = 4;
+        int coin_count = 30;
+        int checkpoint_count = 2;
+    };
+
+    // Seeded generator for levels in the text format used by World and the level editor
+    // (# solid, P spawn, F flag, E enemy, V flying enemy, O coin, C checkpoint). The same
+    // settings always give the same level, on every platform, so stress levels of any size
+    // can be recreated from a handful of numbers.
+    class LevelGenerator {
+    public:
+        explicit LevelGenerator(const LevelGeneratorSettings& settings);
+
+        [[nodiscard]] std::string generate() const;
+
+        static constexpr int MIN_WIDTH = 16;
+        static constexpr int MIN_HEIGHT = 8;
+
+    private:
+        LevelGeneratorSettings m_settings;
+    };
+
+} // namespace core
@@ -0,0 +1,88 @@
+#include "MappedFile.hpp"
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PLATFORMER_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace core {
+
+    std::optional<MappedFile> MappedFile::open(const std::filesystem::path& path) {
+        MappedFile file;
+#ifdef PLATFORMER_HAS_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            std::cerr << "[ERROR] Cannot open file: " << path << std::endl;
+            return std::nullopt;
+        }
+        struct stat info{};
+        if (::fstat(fd, &info) != 0) {
+            std::cerr << "[ERROR] Cannot stat file: " << path << std::endl;
+            ::close(fd);
+            return std::nullopt;
+        }
+        file.m_size = static_cast<size_t>(info.st_size);
+        if (file.m_size > 0) {
+            void* data = ::mmap(nullptr, file.m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                std::cerr << "[ERROR] Cannot map file: " << path << std::endl;
+                ::close(fd);
+                return std::nullopt;
+            }
+            file.m_data = static_cast<const std::byte*>(data);
+            file.m_mapped = true;
+        }
+        // The mapping keeps the file alive on its own
+        ::close(fd);
+#else
+        std::ifstream stream(path, std::ios::binary | std::ios::ate);
+        if (!stream) {
+            std::cerr << "[ERROR] Cannot open file: " << path << std::endl;
+            return std::nullopt;
+        }
+        file.m_copy.resize(static_cast<size_t>(stream.tellg()));
+        stream.seekg(0);
+        stream.read(reinterpret_cast<char*>(file.m_copy.data()), static_cast<std::streamsize>(file.m_copy.size()));
+        file.m_data = file.m_copy.data();
+        file.m_size = file.m_copy.size();
+#endif
+        return file;
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)),
+          m_mapped(std::exchange(other.m_mapped, false)), m_copy(std::move(other.m_copy)) {}
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_mapped = std::exchange(other.m_mapped, false);
+            m_copy = std::move(other.m_copy);
+        }
+        return *this;
+    }
+
+    MappedFile::~MappedFile() {
+        unmap();
+    }
+
+    void MappedFile::unmap() {
+#ifdef PLATFORMER_HAS_MMAP
+        if (m_mapped) {
+            ::munmap(const_cast<std::byte*>(m_data), m_size);
+        }
+#endif
+        m_data = nullptr;
+        m_size = 0;
+        m_mapped = false;
+    }
+
+} // namespace core
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace core {
+
+    // Read-only view of a whole file. On POSIX systems the file is memory-mapped, so opening
+    // it costs no copy and pages are only read when touched; elsewhere it is read into memory.
+    class MappedFile {
+    public:
+        // nullopt (and an error on stderr) when the file cannot be opened or mapped
+        [[nodiscard]] static std::optional<MappedFile> open(const std::filesystem::path& path);
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile();
+
+        [[nodiscard]] std::span<const std::byte> bytes() const { return {m_data, m_size}; }
+
+    private:
+        MappedFile() = default;
+        void unmap();
+
+        const std::byte* m_data = nullptr;
+        size_t m_size = 0;
+        bool m_mapped = false;         // m_data comes from mmap and must be unmapped
+        std::vector<std::byte> m_copy; // Backing store when the file was read instead
+    };
+
+} // namespace core
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+namespace core {
+
+    // FNV-1a, 64 bit. constexpr so names written in the source are hashed by the compiler.
+    constexpr std::uint64_t hash_name(std::string_view name) {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (char c : name) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // A resource name with its hash. String literals are hashed at compile time; names built
+    // at runtime (skins, custom assets) are hashed once when the handle is resolved.
+    struct ResourceName {
+        template <size_t N>
+        consteval ResourceName(const char (&literal)[N]) : text(literal, N - 1), hash(hash_name(text)) {}
+        constexpr explicit ResourceName(std::string_view name) : text(name), hash(hash_name(name)) {}
+
+        std::string_view text;
+        std::uint64_t hash;
+    };
+
+    // Small integer handles into ResourceManager's slot tables. Resolve a name once (at
+    // load time) and keep the handle; using it is an array index, no hashing.
+    template <typename Tag>
+    struct ResourceHandle {
+        static constexpr std::uint32_t INVALID = std::numeric_limits<std::uint32_t>::max();
+
+        std::uint32_t index = INVALID;
+
+        [[nodiscard]] constexpr bool is_valid() const { return index != INVALID; }
+        constexpr bool operator==(const ResourceHandle&) const = default;
+    };
+
+    using TextureId = ResourceHandle<struct TextureTag>;
+    using SoundId = ResourceHandle<struct SoundTag>;
+
+} // namespace core
@@ -1,5 +1,7 @@
 #include "ResourceManager.hpp"
 #include <iostream>
+#include <algorithm>
+#include <functional>
 
 namespace core {
 
@@ -14,6 +16,11 @@ namespace core {
         }
 
         sf::Texture texture;
+        if (m_headless) {
+            // Empty texture: no file IO and no GL context needed
+            auto [it, inserted] = m_textures.emplace(name, std::move(texture));
+            return it->second;
+        }
         if (!texture.loadFromFile(path.string())) {
             std::cerr << "[WARNING] Failed to load texture: " << path << ". Using fallback." << std::endl;
             texture = create_fallback_texture();
@@ -32,6 +39,22 @@ namespace core {
         return m_textures[name];
     }
 
+    sf::Texture& ResourceManager::add_texture(const std::string& name, const sf::Image* image) {
+        if (auto it = m_textures.find(name); it != m_textures.end()) {
+            return it->second;
+        }
+
+        sf::Texture texture;
+        if (!m_headless) {
+            if (!image || !texture.loadFromImage(*image)) {
+                texture = create_fallback_texture();
+            }
+        }
+
+        auto [it, inserted] = m_textures.emplace(name, std::move(texture));
+        return it->second;
+    }
+
     bool ResourceManager::has_texture(const std::string& name) const {
         return m_textures.find(name) != m_textures.end();
     }
@@ -45,23 +68,79 @@ namespace core {
     }
 
     void ResourceManager::play_sound(const std::string& name) {
+        if (m_headless) return;
         if (!has_sound_buffer(name)) {
              std::cerr << "[WARNING] Cannot play sound '" << name << "': Buffer not found." << std::endl;
              return;
         }
         
-        // Create a new sound instance
-        m_active_sounds.emplace_back(get_sound_buffer(name));
-        m_active_sounds.back().play();
-        
-        // Clean up finished sounds
-        clean_sounds();
+        // The buffer exists, so this only resolves (or creates) its slot
+        play_sound(load_sound_id(ResourceName(std::string_view(name)), {}));
     }
 
-    void ResourceManager::clean_sounds() {
-        m_active_sounds.remove_if([](const sf::Sound& sound) {
-            return sound.getStatus() == sf::Sound::Status::Stopped;
-        });
+    void ResourceManager::play_sound(SoundId id) {
+        if (m_headless) return;
+        if (!id.is_valid()) {
+            std::cerr << "[WARNING] Cannot play sound: invalid handle." << std::endl;
+            return;
+        }
+
+        const SoundSettings& settings = m_sound_settings[id.index];
+        Voice* voice = pick_voice(id.index, settings);
+        if (!voice) return;
+
+        const sf::SoundBuffer& buffer = *m_sound_slots[id.index];
+        if (!voice->sound) {
+            voice->sound.emplace(buffer);
+        } else if (voice->slot == id.index) {
+            // Same buffer: restart only. Rebinding registers the sound with the buffer
+            // again, which allocates.
+            voice->sound->stop();
+        } else {
+            voice->sound->stop();
+            voice->sound->setBuffer(buffer);
+        }
+        voice->slot = id.index;
+        voice->priority = settings.priority;
+        voice->started = ++m_voice_clock;
+        voice->sound->play();
+    }
+
+    ResourceManager::Voice* ResourceManager::pick_voice(std::uint32_t slot, const SoundSettings& settings) {
+        Voice* free_voice = nullptr;
+        Voice* free_same = nullptr;   // Idle voice still bound to this sound, needs no rebinding
+        Voice* oldest_same = nullptr; // Oldest playing instance of this sound
+        Voice* victim = nullptr;      // Lowest priority, then oldest, among those we may steal
+        int same_count = 0;
+
+        for (auto& voice : m_voices) {
+            if (!voice.is_playing()) {
+                if (!free_voice) free_voice = &voice;
+                if (!free_same && voice.slot == slot) free_same = &voice;
+                continue;
+            }
+            if (voice.slot == slot) {
+                same_count++;
+                if (!oldest_same || voice.started < oldest_same->started) oldest_same = &voice;
+            }
+            if (voice.priority <= settings.priority &&
+                (!victim || voice.priority < victim->priority ||
+                 (voice.priority == victim->priority && voice.started < victim->started))) {
+                victim = &voice;
+            }
+        }
+
+        if (settings.max_voices > 0 && same_count >= settings.max_voices) return oldest_same;
+        if (free_same) return free_same;
+        if (free_voice) return free_voice;
+        return victim;
+    }
+
+    void ResourceManager::stop_all_sounds(SoundId keep) {
+        for (auto& voice : m_voices) {
+            if (keep.is_valid() && voice.slot == keep.index) continue;
+            if (voice.sound) voice.sound->stop();
+        }
     }
 
     sf::Font& ResourceManager::load_font(const std::string& name, const std::filesystem::path& path) {
@@ -111,7 +190,7 @@ namespace core {
         }
 
         sf::SoundBuffer buffer;
-        if (!buffer.loadFromFile(path.string())) {
+        if (!m_headless && !buffer.loadFromFile(path.string())) {
             std::cerr << "[ERROR] Failed to load sound buffer: " << path << std::endl;
             // We could return a dummy buffer or handle this better
         }
@@ -120,6 +199,11 @@ namespace core {
         return it->second;
     }
 
+    sf::SoundBuffer& ResourceManager::add_sound_buffer(const std::string& name, sf::SoundBuffer&& buffer) {
+        auto [it, inserted] = m_sound_buffers.try_emplace(name, std::move(buffer));
+        return it->second;
+    }
+
     sf::SoundBuffer& ResourceManager::get_sound_buffer(const std::string& name) {
         if (m_sound_buffers.contains(name)) {
             return m_sound_buffers.at(name);
@@ -129,7 +213,205 @@ namespace core {
         return empty_buffer;
     }
 
-    sf::Texture ResourceManager::create_fallback_texture() {
+    std::uint32_t ResourceManager::find_slot(const std::unordered_map<std::uint64_t, std::uint32_t>& ids,
+                                             const std::vector<std::string>& names, ResourceName name) const {
+        auto it = ids.find(name.hash);
+        if (it == ids.end()) return TextureId::INVALID;
+        if (names[it->second] != name.text) {
+            std::cerr << "[ERROR] Resource names '" << names[it->second] << "' and '" << name.text
+                      << "' have the same hash; rename one of them." << std::endl;
+            return TextureId::INVALID;
+        }
+        return it->second;
+    }
+
+    TextureId ResourceManager::load_texture_id(ResourceName name, const std::filesystem::path& path) {
+        if (std::uint32_t slot = find_slot(m_texture_ids, m_texture_slot_names, name); slot != TextureId::INVALID) {
+            return TextureId{slot};
+        }
+        if (m_texture_ids.contains(name.hash)) return TextureId{}; // Hash collision, reported above
+        std::string text(name.text);
+        TextureRegion region = load_region(text, path);
+        auto slot = static_cast<std::uint32_t>(m_texture_slots.size());
+        m_texture_slots.push_back(region);
+        m_texture_slot_names.push_back(std::move(text));
+        m_texture_ids.emplace(name.hash, slot);
+        return TextureId{slot};
+    }
+
+    TextureId ResourceManager::get_texture_id(ResourceName name) {
+        if (std::uint32_t slot = find_slot(m_texture_ids, m_texture_slot_names, name); slot != TextureId::INVALID) {
+            return TextureId{slot};
+        }
+        if (m_texture_ids.contains(name.hash)) return TextureId{}; // Hash collision, reported above
+        std::string text(name.text);
+        // No slot for names that are not loaded: it would pin the fallback and a later
+        // load_texture_id() would return it without reading the file
+        if (!has_region(text) && !has_texture(text)) return TextureId{};
+        TextureRegion region = get_region(text);
+        auto slot = static_cast<std::uint32_t>(m_texture_slots.size());
+        m_texture_slots.push_back(region);
+        m_texture_slot_names.push_back(std::move(text));
+        m_texture_ids.emplace(name.hash, slot);
+        return TextureId{slot};
+    }
+
+    const TextureRegion& ResourceManager::get_region(TextureId id) {
+        if (!id.is_valid()) return fallback_region();
+        return m_texture_slots[id.index];
+    }
+
+    const TextureRegion& ResourceManager::fallback_region() {
+        if (!m_fallback_region) {
+            // Headless runs have no GL context to upload the checkerboard with
+            static sf::Texture fallback = m_headless ? sf::Texture() : create_fallback_texture();
+            m_fallback_region = whole_texture_region(fallback);
+        }
+        return *m_fallback_region;
+    }
+
+    SoundId ResourceManager::load_sound_id(ResourceName name, const std::filesystem::path& path) {
+        if (std::uint32_t slot = find_slot(m_sound_ids, m_sound_slot_names, name); slot != SoundId::INVALID) {
+            return SoundId{slot};
+        }
+        if (m_sound_ids.contains(name.hash)) return SoundId{}; // Hash collision, reported above
+        std::string text(name.text);
+        const sf::SoundBuffer& buffer = load_sound_buffer(text, path);
+        auto slot = static_cast<std::uint32_t>(m_sound_slots.size());
+        m_sound_slots.push_back(&buffer);
+        m_sound_settings.emplace_back();
+        m_sound_slot_names.push_back(std::move(text));
+        m_sound_ids.emplace(name.hash, slot);
+        return SoundId{slot};
+    }
+
+    SoundId ResourceManager::load_sound_id(const SoundAsset& sound) {
+        SoundId id = load_sound_id(sound.name, sound.path);
+        if (id.is_valid()) {
+            m_sound_settings[id.index] = {sound.priority, sound.max_voices};
+        }
+        return id;
+    }
+
+    void ResourceManager::register_atlas_image(const std::string& name, const std::filesystem::path& path) {
+        if (m_regions.contains(name)) return;
+        m_atlas_requests.emplace_back(name, path);
+    }
+
+    void ResourceManager::build_atlases() {
+        struct PendingImage {
+            std::string name;
+            sf::Image image;
+        };
+
+        std::vector<PendingImage> images;
+        images.reserve(m_atlas_requests.size());
+        for (const auto& [name, path] : m_atlas_requests) {
+            sf::Image image;
+            if (!image.loadFromFile(path)) {
+                std::cerr << "[WARNING] Failed to load atlas image: " << path << ". Using fallback." << std::endl;
+                image = create_fallback_image();
+            }
+            images.push_back({name, std::move(image)});
+        }
+        m_atlas_requests.clear();
+
+        // Shelf packing: tallest images first keeps every shelf tight
+        std::ranges::sort(images, std::greater{}, [](const PendingImage& p) { return p.image.getSize().y; });
+
+        sf::Image page({ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE}, sf::Color::Transparent);
+        std::vector<std::pair<std::string, sf::IntRect>> page_regions;
+        unsigned int cursor_x = 0;
+        unsigned int cursor_y = 0;
+        unsigned int shelf_height = 0;
+
+        // Uploads the current page (cropped to the used height) and publishes its regions
+        auto flush_page = [&]() {
+            if (page_regions.empty()) return;
+            unsigned int used_height = std::min(ATLAS_PAGE_SIZE, cursor_y + shelf_height);
+            sf::Texture& texture = m_atlas_pages.emplace_back();
+            sf::IntRect used_area({0, 0}, {static_cast<int>(ATLAS_PAGE_SIZE), static_cast<int>(used_height)});
+            if (!texture.loadFromImage(page, false, used_area)) {
+                std::cerr << "[ERROR] Failed to upload atlas page " << m_atlas_pages.size() << std::endl;
+            }
+            for (const auto& [name, rect] : page_regions) {
+                m_regions[name] = TextureRegion{&texture, rect};
+            }
+            page_regions.clear();
+            page = sf::Image({ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE}, sf::Color::Transparent);
+            cursor_x = 0;
+            cursor_y = 0;
+            shelf_height = 0;
+        };
+
+        for (const auto& pending : images) {
+            sf::Vector2u size = pending.image.getSize();
+            if (size.x > ATLAS_PAGE_SIZE || size.y > ATLAS_PAGE_SIZE) {
+                // Too big for a page: keep it as a standalone texture
+                sf::Texture& texture = m_textures[pending.name];
+                if (!texture.loadFromImage(pending.image)) {
+                    texture = create_fallback_texture();
+                }
+                m_regions[pending.name] = TextureRegion{&texture, sf::IntRect({0, 0}, sf::Vector2i(texture.getSize()))};
+                continue;
+            }
+
+            if (cursor_x + size.x > ATLAS_PAGE_SIZE) {
+                // Next shelf
+                cursor_x = 0;
+                cursor_y += shelf_height + ATLAS_PADDING;
+                shelf_height = 0;
+            }
+            if (cursor_y + size.y > ATLAS_PAGE_SIZE) {
+                flush_page();
+            }
+
+            if (!page.copy(pending.image, {cursor_x, cursor_y})) {
+                std::cerr << "[ERROR] Failed to pack " << pending.name << " into the atlas" << std::endl;
+                continue;
+            }
+            page_regions.emplace_back(pending.name, sf::IntRect({static_cast<int>(cursor_x), static_cast<int>(cursor_y)},
+                                                                sf::Vector2i(size)));
+            cursor_x += size.x + ATLAS_PADDING;
+            shelf_height = std::max(shelf_height, size.y);
+        }
+        flush_page();
+
+        // Handles resolved before packing now point into the atlas
+        for (size_t i = 0; i < m_texture_slots.size(); ++i) {
+            if (auto it = m_regions.find(m_texture_slot_names[i]); it != m_regions.end()) {
+                m_texture_slots[i] = it->second;
+            }
+        }
+
+        std::cout << "Packed " << m_regions.size() << " sprites into " << m_atlas_pages.size() << " atlas page(s)" << std::endl;
+    }
+
+    TextureRegion ResourceManager::load_region(const std::string& name, const std::filesystem::path& path) {
+        if (auto it = m_regions.find(name); it != m_regions.end()) {
+            return it->second;
+        }
+
+        // Not packed: fall back to a standalone texture covering the whole image
+        return whole_texture_region(load_texture(name, path));
+    }
+
+    TextureRegion ResourceManager::get_region(const std::string& name) {
+        if (auto it = m_regions.find(name); it != m_regions.end()) {
+            return it->second;
+        }
+
+        return whole_texture_region(get_texture(name));
+    }
+
+    TextureRegion ResourceManager::whole_texture_region(const sf::Texture& texture) const {
+        // Headless textures are empty; a nominal size keeps sprite scaling finite
+        sf::Vector2i size = m_headless ? sf::Vector2i(HEADLESS_REGION_SIZE, HEADLESS_REGION_SIZE)
+                                       : sf::Vector2i(texture.getSize());
+        return TextureRegion{&texture, sf::IntRect({0, 0}, size)};
+    }
+
+    sf::Image ResourceManager::create_fallback_image() {
         sf::Image image;
         image.resize({32, 32}, sf::Color::Magenta); 
         
@@ -140,6 +422,11 @@ namespace core {
                 }
             }
         }
+        return image;
+    }
+
+    sf::Texture ResourceManager::create_fallback_texture() {
+        sf::Image image = create_fallback_image();
 
         sf::Texture texture;
         if (!texture.loadFromImage(image)) {
@@ -2,16 +2,35 @@
 
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
+#include "ResourceId.hpp"
+#include "SoundManifest.hpp"
 #include <unordered_map>
 #include <string>
 #include <memory>
 #include <filesystem>
 #include <iostream>
 #include <expected>
-#include <list>
+#include <array>
+#include <deque>
+#include <optional>
+#include <vector>
+#include <cstdint>
 
 namespace core {
 
+    // A sub-rectangle of a texture. Regions handed out by the atlas point into a shared
+    // atlas page, so sprites and vertex arrays using them can be batched together.
+    struct TextureRegion {
+        const sf::Texture* texture = nullptr;
+        sf::IntRect rect;
+
+        // Points a sprite at this region (texture page + sub-rectangle)
+        void apply_to(sf::Sprite& sprite) const {
+            sprite.setTexture(*texture);
+            sprite.setTextureRect(rect);
+        }
+    };
+
     class ResourceManager {
     public:
         static ResourceManager& instance();
@@ -19,31 +38,123 @@ namespace core {
         ResourceManager(const ResourceManager&) = delete;
         ResourceManager& operator=(const ResourceManager&) = delete;
 
+        // Headless mode (simulation without a window): textures are placeholders that never
+        // touch the GPU and sounds are neither decoded nor played. Set it before loading anything.
+        void set_headless(bool headless) { m_headless = headless; }
+        [[nodiscard]] bool is_headless() const { return m_headless; }
+
         [[nodiscard]] sf::Texture& load_texture(const std::string& name, const std::filesystem::path& path);
         [[nodiscard]] sf::Texture& get_texture(const std::string& name);
+        // Uploads an image decoded elsewhere (see AssetLoader); nullptr stores the fallback.
+        // Must run on the thread that owns the GL context.
+        sf::Texture& add_texture(const std::string& name, const sf::Image* image);
         [[nodiscard]] bool has_texture(const std::string& name) const;
         bool has_font(const std::string& name) const;
         bool has_sound_buffer(const std::string& name) const;
         
+        // Plays through the voice pool with default priority and no cap (see play_sound(SoundId))
         void play_sound(const std::string& name);
-        void clean_sounds(); // Call this occasionally to remove stopped sounds
 
         [[nodiscard]] sf::Font& load_font(const std::string& name, const std::filesystem::path& path);
         [[nodiscard]] sf::Font& get_font(const std::string& name);
 
+        // Texture Atlas
+        // Images registered before build_atlases() are packed into a few large pages at
+        // startup (needs a GL context, so call it once the window exists).
+        void register_atlas_image(const std::string& name, const std::filesystem::path& path);
+        void build_atlases();
+        // Atlas region for `name`, or the whole standalone texture loaded from `path` when the
+        // image was not packed (not registered, or atlas not built yet). Also usable to preload.
+        TextureRegion load_region(const std::string& name, const std::filesystem::path& path);
+        // Same lookup for names already loaded; unknown names get the fallback texture
+        [[nodiscard]] TextureRegion get_region(const std::string& name);
+        [[nodiscard]] bool has_region(const std::string& name) const { return m_regions.contains(name); }
+        [[nodiscard]] size_t get_atlas_page_count() const { return m_atlas_pages.size(); }
+
         // Sound Buffer Management
         sf::SoundBuffer& load_sound_buffer(const std::string& name, const std::filesystem::path& path);
         sf::SoundBuffer& get_sound_buffer(const std::string& name);
+        sf::SoundBuffer& add_sound_buffer(const std::string& name, sf::SoundBuffer&& buffer);
+
+        // Handles (see ResourceId.hpp). Resolve names at load time, then use the handle on
+        // hot paths: get_region(TextureId) and play_sound(SoundId) are plain array lookups.
+        // Texture handles name regions, so they follow atlas packing like load_region().
+        TextureId load_texture_id(ResourceName name, const std::filesystem::path& path);
+        // Handle for a region loaded earlier; unknown names give an invalid handle (drawn
+        // as the fallback texture)
+        [[nodiscard]] TextureId get_texture_id(ResourceName name);
+        // Invalid handles give the fallback texture
+        [[nodiscard]] const TextureRegion& get_region(TextureId id);
+        SoundId load_sound_id(ResourceName name, const std::filesystem::path& path);
+        // Also applies the asset's priority and voice cap
+        SoundId load_sound_id(const SoundAsset& sound);
+        // Plays on one of MAX_VOICES pooled voices. Voices that last played the same sound
+        // are reused first and only restarted, so repeats allocate nothing. A sound at its
+        // cap restarts its oldest instance; with every voice busy it steals the oldest voice
+        // of equal or lower priority, or is dropped.
+        void play_sound(SoundId id);
+        // Silences every voice, e.g. when a level is torn down, except those playing `keep`
+        // (such as the click of the button that triggered the teardown)
+        void stop_all_sounds(SoundId keep = {});
+
+        static constexpr size_t MAX_VOICES = 32;
 
     private:
         ResourceManager() = default;
 
         sf::Texture create_fallback_texture();
+        sf::Image create_fallback_image();
+        TextureRegion whole_texture_region(const sf::Texture& texture) const;
+        const TextureRegion& fallback_region();
+        // Slot index for `name`, or INVALID when it has none or another name has the same
+        // hash (reported on stderr)
+        std::uint32_t find_slot(const std::unordered_map<std::uint64_t, std::uint32_t>& ids,
+                                const std::vector<std::string>& names, ResourceName name) const;
+        struct SoundSettings {
+            int priority = 0;
+            int max_voices = 0;
+        };
+
+        struct Voice {
+            std::optional<sf::Sound> sound; // Created on first use, then only rebound
+            std::uint32_t slot = SoundId::INVALID;
+            int priority = 0;
+            std::uint64_t started = 0; // m_voice_clock at play(), orders voices by age
+
+            [[nodiscard]] bool is_playing() const {
+                return sound && sound->getStatus() != sf::Sound::Status::Stopped;
+            }
+        };
+
+        // Voice to play `slot` on, or nullptr when every voice outranks it
+        Voice* pick_voice(std::uint32_t slot, const SoundSettings& settings);
 
         std::unordered_map<std::string, sf::Texture> m_textures;
         std::unordered_map<std::string, sf::Font> m_fonts;
         std::unordered_map<std::string, sf::SoundBuffer> m_sound_buffers;
-        std::list<sf::Sound> m_active_sounds;
+        std::array<Voice, MAX_VOICES> m_voices; // After the buffers, so voices stop first
+        std::uint64_t m_voice_clock = 0;
+        bool m_headless = false;
+
+        // Atlas pages live in a deque so regions can keep pointers to them
+        std::vector<std::pair<std::string, std::filesystem::path>> m_atlas_requests;
+        std::deque<sf::Texture> m_atlas_pages;
+        std::unordered_map<std::string, TextureRegion> m_regions;
+
+        // Handle slots, indexed by TextureId/SoundId. The hash maps are only probed while
+        // resolving a name; textures and buffers live in node-based maps, so pointers stay valid.
+        std::vector<TextureRegion> m_texture_slots;
+        std::vector<std::string> m_texture_slot_names;
+        std::unordered_map<std::uint64_t, std::uint32_t> m_texture_ids;
+        std::vector<const sf::SoundBuffer*> m_sound_slots;
+        std::vector<SoundSettings> m_sound_settings;
+        std::vector<std::string> m_sound_slot_names;
+        std::unordered_map<std::uint64_t, std::uint32_t> m_sound_ids;
+        std::optional<TextureRegion> m_fallback_region;
+
+        static constexpr unsigned int ATLAS_PAGE_SIZE = 2048;
+        static constexpr unsigned int ATLAS_PADDING = 2; // Transparent gap against filtering bleed
+        static constexpr int HEADLESS_REGION_SIZE = 32;  // Nominal sprite size when nothing is loaded
     };
 
 } // namespace core
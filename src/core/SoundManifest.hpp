@@ -0,0 +1,27 @@
+#pragma once
+
+#include "ResourceId.hpp"
+#include <array>
+
+namespace core {
+
+    struct SoundAsset {
+        ResourceName name;
+        const char* path;
+        int priority = 0;   // When the voice pool is full, higher priorities steal from lower ones
+        int max_voices = 0; // Simultaneous instances, 0 for no cap; the oldest one restarts
+    };
+
+    // Every sound a level can play. The whole list is preloaded with the level (see
+    // World::queue_assets), so each buffer is decoded once per process; entities resolve
+    // SoundIds from these entries, which after the preload is a slot lookup.
+    namespace sounds {
+        inline constexpr SoundAsset PLAYER_JUMP{"player_jump", "assets/Pack_to_pick/Game/Sounds/sfx_jump.ogg", 1, 2};
+        inline constexpr SoundAsset PLAYER_DAMAGE{"player_damage", "assets/sounds/damage.ogg", 3, 1};
+        inline constexpr SoundAsset COIN_COLLECT{"coin_collect", "assets/Pack_to_pick/Game/Sounds/sfx_coin.ogg", 0, 4};
+        inline constexpr SoundAsset BUTTON_CLICK{"click_sound", "assets/menu/click.ogg", 2, 1};
+
+        inline constexpr std::array LEVEL{PLAYER_JUMP, PLAYER_DAMAGE, COIN_COLLECT, BUTTON_CLICK};
+    }
+
+} // namespace core
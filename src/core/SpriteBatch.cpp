@@ -0,0 +1,57 @@
+#include "SpriteBatch.hpp"
+#include <utility>
+
+namespace core {
+
+    void SpriteBatch::append_quad(sf::VertexArray& vertices, const sf::FloatRect& bounds, const sf::IntRect& uv, bool flip_x) {
+        const sf::Vector2f pos = bounds.position;
+        const sf::Vector2f end = bounds.position + bounds.size;
+        sf::Vector2f uv_min(uv.position);
+        sf::Vector2f uv_max(uv.position + uv.size);
+        if (flip_x) std::swap(uv_min.x, uv_max.x);
+
+        const sf::Vertex top_left{pos, sf::Color::White, uv_min};
+        const sf::Vertex top_right{{end.x, pos.y}, sf::Color::White, {uv_max.x, uv_min.y}};
+        const sf::Vertex bottom_left{{pos.x, end.y}, sf::Color::White, {uv_min.x, uv_max.y}};
+        const sf::Vertex bottom_right{end, sf::Color::White, uv_max};
+
+        vertices.append(top_left);
+        vertices.append(top_right);
+        vertices.append(bottom_left);
+        vertices.append(bottom_left);
+        vertices.append(top_right);
+        vertices.append(bottom_right);
+    }
+
+    void SpriteBatch::add(const TextureRegion& region, const sf::FloatRect& bounds, bool flip_x) {
+        if (!region.texture) return;
+
+        // Few pages are live at once, a linear search beats a map here
+        Page* page = nullptr;
+        for (size_t i = 0; i < m_pages_used; ++i) {
+            if (m_pages[i].texture == region.texture) {
+                page = &m_pages[i];
+                break;
+            }
+        }
+        if (!page) {
+            if (m_pages_used == m_pages.size()) m_pages.emplace_back();
+            page = &m_pages[m_pages_used++];
+            page->texture = region.texture;
+            page->vertices.clear();
+        }
+
+        append_quad(page->vertices, bounds, region.rect, flip_x);
+        m_quad_count++;
+    }
+
+    void SpriteBatch::draw(GameWindow& window) {
+        for (size_t i = 0; i < m_pages_used; ++i) {
+            window.draw(m_pages[i].vertices, sf::RenderStates(m_pages[i].texture));
+            m_pages[i].vertices.clear();
+        }
+        m_pages_used = 0;
+        m_quad_count = 0;
+    }
+
+} // namespace core
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "GameWindow.hpp"
+#include "ResourceManager.hpp"
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+namespace core {
+
+    // Collects textured quads for a frame and draws them with one call per texture page.
+    // With the atlas most sprites share a page, so drawing N entities costs a handful of
+    // draw calls instead of N. Quads on the same page keep the order they were added in;
+    // pages are drawn in the order they were first used, so quads on different pages only
+    // stack correctly within one draw(). Call draw() between layers that must not interleave.
+    class SpriteBatch {
+    public:
+        // Queues `region` stretched over `bounds` (world coordinates), mirrored horizontally
+        // inside the same box when flip_x is set
+        void add(const TextureRegion& region, const sf::FloatRect& bounds, bool flip_x = false);
+        // Draws everything queued since the last draw() and empties the batch (capacity is kept)
+        void draw(GameWindow& window);
+
+        [[nodiscard]] size_t get_quad_count() const { return m_quad_count; }
+
+        // Appends a quad as two triangles; shared with the tile chunk baking
+        static void append_quad(sf::VertexArray& vertices, const sf::FloatRect& bounds, const sf::IntRect& uv, bool flip_x = false);
+
+    private:
+        struct Page {
+            const sf::Texture* texture = nullptr;
+            sf::VertexArray vertices{sf::PrimitiveType::Triangles};
+        };
+        // Pages persist across frames so their vertex storage is reused; the first
+        // m_pages_used of them are live this frame
+        std::vector<Page> m_pages;
+        size_t m_pages_used = 0;
+        size_t m_quad_count = 0;
+    };
+
+} // namespace core
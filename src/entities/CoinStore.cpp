@@ -0,0 +1,124 @@
+#include "CoinStore.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace entities {
+
+    CoinStore::CoinStore(std::pmr::memory_resource* memory)
+        : m_positions(memory), m_spawn_ids(memory), m_next(memory), m_prev(memory), m_column_heads(memory) {
+        auto& rm = core::ResourceManager::instance();
+        m_region = rm.load_region("coin_gold", "assets/gameplay/items/coin_gold.png");
+        m_collect_sound = rm.load_sound_id(core::sounds::COIN_COLLECT);
+    }
+
+    void CoinStore::set_columns(int columns) {
+        clear();
+        m_column_heads.assign(static_cast<size_t>(std::max(columns, 1)), NONE);
+    }
+
+    int CoinStore::column_of(float x) const {
+        int column = static_cast<int>(std::floor(x / CELL_SIZE));
+        return std::clamp(column, 0, static_cast<int>(m_column_heads.size()) - 1);
+    }
+
+    void CoinStore::link(size_t index) {
+        std::int32_t& head = m_column_heads[column_of(m_positions[index].x)];
+        m_prev[index] = NONE;
+        m_next[index] = head;
+        if (head != NONE) m_prev[head] = static_cast<std::int32_t>(index);
+        head = static_cast<std::int32_t>(index);
+    }
+
+    void CoinStore::unlink(size_t index) {
+        std::int32_t prev = m_prev[index];
+        std::int32_t next = m_next[index];
+        if (prev != NONE) {
+            m_next[prev] = next;
+        } else {
+            m_column_heads[column_of(m_positions[index].x)] = next;
+        }
+        if (next != NONE) m_prev[next] = prev;
+    }
+
+    void CoinStore::spawn(const sf::Vector2f& position, std::uint32_t spawn_id) {
+        if (m_column_heads.empty()) set_columns(1);
+        m_positions.push_back(position);
+        m_spawn_ids.push_back(spawn_id);
+        m_next.push_back(NONE);
+        m_prev.push_back(NONE);
+        link(m_positions.size() - 1);
+    }
+
+    void CoinStore::remove(size_t index) {
+        unlink(index);
+        size_t last = m_positions.size() - 1;
+        if (index != last) {
+            // The last coin takes over the freed slot; repoint its neighbours at the new index
+            m_positions[index] = m_positions[last];
+            m_spawn_ids[index] = m_spawn_ids[last];
+            m_next[index] = m_next[last];
+            m_prev[index] = m_prev[last];
+            auto moved = static_cast<std::int32_t>(index);
+            if (m_prev[index] != NONE) {
+                m_next[m_prev[index]] = moved;
+            } else {
+                m_column_heads[column_of(m_positions[index].x)] = moved;
+            }
+            if (m_next[index] != NONE) m_prev[m_next[index]] = moved;
+        }
+        m_positions.pop_back();
+        m_spawn_ids.pop_back();
+        m_next.pop_back();
+        m_prev.pop_back();
+    }
+
+    void CoinStore::clear() {
+        m_positions.clear();
+        m_spawn_ids.clear();
+        m_next.clear();
+        m_prev.clear();
+        std::ranges::fill(m_column_heads, NONE);
+    }
+
+    void CoinStore::reserve(size_t count) {
+        m_positions.reserve(count);
+        m_spawn_ids.reserve(count);
+        m_next.reserve(count);
+        m_prev.reserve(count);
+    }
+
+    void CoinStore::collect(size_t index) {
+        remove(index);
+        core::ResourceManager::instance().play_sound(m_collect_sound);
+    }
+
+    std::optional<size_t> CoinStore::find_overlap(const sf::FloatRect& area) const {
+        if (m_positions.empty()) return std::nullopt;
+
+        // A coin sits inside its own column, so the columns under the area are enough
+        int first = column_of(area.position.x);
+        int last = column_of(area.position.x + area.size.x);
+        for (int column = first; column <= last; ++column) {
+            for (std::int32_t i = m_column_heads[column]; i != NONE; i = m_next[i]) {
+                if (area.findIntersection(get_bounds(static_cast<size_t>(i)))) {
+                    return static_cast<size_t>(i);
+                }
+            }
+        }
+        return std::nullopt;
+    }
+
+    void CoinStore::render(core::SpriteBatch& batch, const sf::View& view) const {
+        if (m_positions.empty()) return;
+
+        float left = view.getCenter().x - view.getSize().x / 2.0f;
+        int first = column_of(left);
+        int last = column_of(left + view.getSize().x);
+        for (int column = first; column <= last; ++column) {
+            for (std::int32_t i = m_column_heads[column]; i != NONE; i = m_next[i]) {
+                batch.add(m_region, get_bounds(static_cast<size_t>(i)));
+            }
+        }
+    }
+
+} // namespace entities
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "../core/ResourceManager.hpp"
+#include "../core/SpriteBatch.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace entities {
+
+    // The uncollected coins of a World as parallel arrays. A coin is removed (swap with the
+    // last one) as soon as it is picked up, so updates and draws only ever see live coins.
+    //
+    // Coins never move, so they are also indexed by tile column: each column heads a doubly
+    // linked list threaded through m_next/m_prev. Overlap tests and drawing only walk the
+    // columns they cover, so thousands of coins elsewhere in the level cost nothing.
+    class CoinStore {
+    public:
+        explicit CoinStore(std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+        // Number of tile columns to index; call before spawning (drops every coin)
+        void set_columns(int columns);
+
+        void spawn(const sf::Vector2f& position, std::uint32_t spawn_id);
+        void remove(size_t index);
+        void clear();
+        void reserve(size_t count);
+
+        // Removes the coin at `index` and plays the pickup sound
+        void collect(size_t index);
+        // Draws the coins in the columns `view` can see
+        void render(core::SpriteBatch& batch, const sf::View& view) const;
+
+        // Index of a coin overlapping `area`, if any
+        [[nodiscard]] std::optional<size_t> find_overlap(const sf::FloatRect& area) const;
+        [[nodiscard]] sf::FloatRect get_bounds(size_t index) const {
+            return sf::FloatRect(m_positions[index] + sf::Vector2f(INSET, INSET), sf::Vector2f(SIZE, SIZE));
+        }
+
+        [[nodiscard]] size_t size() const { return m_positions.size(); }
+        [[nodiscard]] std::span<const sf::Vector2f> get_positions() const { return m_positions; }
+        [[nodiscard]] std::span<const std::uint32_t> get_spawn_ids() const { return m_spawn_ids; }
+
+        static constexpr float SIZE = 24.0f;  // Slightly smaller than a tile
+        static constexpr float INSET = 4.0f;  // Centres the coin in its tile
+        static constexpr float CELL_SIZE = 32.0f; // Tile size, the width of one index column
+
+    private:
+        static constexpr std::int32_t NONE = -1;
+
+        // Index column of x, clamped so stray positions land in the edge columns
+        [[nodiscard]] int column_of(float x) const;
+        void link(size_t index);
+        void unlink(size_t index);
+
+        std::pmr::vector<sf::Vector2f> m_positions; // Tile top-left
+        std::pmr::vector<std::uint32_t> m_spawn_ids;
+        std::pmr::vector<std::int32_t> m_next;      // Next coin in the same column, or NONE
+        std::pmr::vector<std::int32_t> m_prev;      // Previous coin in the same column, or NONE
+        std::pmr::vector<std::int32_t> m_column_heads;
+
+        core::TextureRegion m_region; // Shared by every coin
+        core::SoundId m_collect_sound;
+    };
+
+} // namespace entities
@@ -0,0 +1,157 @@
+#include "EnemyStore.hpp"
+#include "../world/TileMap.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace entities {
+
+    EnemyStore::EnemyStore(std::pmr::memory_resource* memory)
+        : m_kinds(memory), m_positions(memory), m_previous_positions(memory), m_velocities(memory),
+          m_directions(memory), m_anchor_y(memory), m_flight_time(memory), m_animation_timers(memory),
+          m_frames(memory), m_spawn_ids(memory) {
+        auto& rm = core::ResourceManager::instance();
+        m_walker_frames[0] = rm.load_region("slime_walk_a", "assets/Pack_to_pick/Game/Sprites/Enemies/Default/slime_normal_walk_a.png");
+        m_walker_frames[1] = rm.load_region("slime_walk_b", "assets/Pack_to_pick/Game/Sprites/Enemies/Default/slime_normal_walk_b.png");
+        m_flyer_frames[0] = rm.load_region("fly_a", "assets/Pack_to_pick/Game/Sprites/Enemies/Default/fly_a.png");
+        m_flyer_frames[1] = rm.load_region("fly_b", "assets/Pack_to_pick/Game/Sprites/Enemies/Default/fly_b.png");
+    }
+
+    void EnemyStore::spawn(Kind kind, const sf::Vector2f& position, std::uint32_t spawn_id) {
+        m_kinds.push_back(kind);
+        m_positions.push_back(position);
+        m_previous_positions.push_back(position);
+        m_velocities.push_back(sf::Vector2f(0.0f, 0.0f));
+        m_directions.push_back(1.0f);
+        m_anchor_y.push_back(position.y);
+        m_flight_time.push_back(0.0f);
+        m_animation_timers.push_back(0.0f);
+        m_frames.push_back(0);
+        m_spawn_ids.push_back(spawn_id);
+    }
+
+    void EnemyStore::remove(size_t index) {
+        auto swap_remove = [index](auto& component) {
+            component[index] = component.back();
+            component.pop_back();
+        };
+        swap_remove(m_kinds);
+        swap_remove(m_positions);
+        swap_remove(m_previous_positions);
+        swap_remove(m_velocities);
+        swap_remove(m_directions);
+        swap_remove(m_anchor_y);
+        swap_remove(m_flight_time);
+        swap_remove(m_animation_timers);
+        swap_remove(m_frames);
+        swap_remove(m_spawn_ids);
+    }
+
+    void EnemyStore::clear() {
+        m_kinds.clear();
+        m_positions.clear();
+        m_previous_positions.clear();
+        m_velocities.clear();
+        m_directions.clear();
+        m_anchor_y.clear();
+        m_flight_time.clear();
+        m_animation_timers.clear();
+        m_frames.clear();
+        m_spawn_ids.clear();
+    }
+
+    void EnemyStore::reserve(size_t count) {
+        m_kinds.reserve(count);
+        m_positions.reserve(count);
+        m_previous_positions.reserve(count);
+        m_velocities.reserve(count);
+        m_directions.reserve(count);
+        m_anchor_y.reserve(count);
+        m_flight_time.reserve(count);
+        m_animation_timers.reserve(count);
+        m_frames.reserve(count);
+        m_spawn_ids.reserve(count);
+    }
+
+    size_t EnemyStore::count(Kind kind) const {
+        size_t total = 0;
+        for (Kind k : m_kinds) {
+            if (k == kind) total++;
+        }
+        return total;
+    }
+
+    void EnemyStore::begin_step() {
+        std::ranges::copy(m_positions, m_previous_positions.begin());
+    }
+
+    void EnemyStore::update(float dt) {
+        const size_t n = m_positions.size();
+
+        // Steering: walkers patrol at a fixed speed, flyers advance their bobbing clock
+        for (size_t i = 0; i < n; ++i) {
+            bool walker = m_kinds[i] == Kind::Walker;
+            m_velocities[i].x = walker ? m_directions[i] * WALK_SPEED : 0.0f;
+            m_flight_time[i] += walker ? 0.0f : dt;
+        }
+
+        // Integration: walkers move with their velocity, flyers follow a sine around their anchor
+        for (size_t i = 0; i < n; ++i) {
+            if (m_kinds[i] == Kind::Walker) {
+                m_positions[i] += m_velocities[i] * dt;
+            } else {
+                m_positions[i].y = m_anchor_y[i] + std::sin(m_flight_time[i] * FLY_SPEED) * FLY_AMPLITUDE;
+            }
+        }
+
+        // Animation: two frames, toggled on a fixed period
+        for (size_t i = 0; i < n; ++i) {
+            m_animation_timers[i] += dt;
+            if (m_animation_timers[i] >= ANIMATION_SPEED) {
+                m_animation_timers[i] = 0.0f;
+                m_frames[i] ^= 1;
+            }
+        }
+    }
+
+    void EnemyStore::resolve_walls(const world::TileMap& tilemap) {
+        for (size_t i = 0; i < m_positions.size(); ++i) {
+            if (m_kinds[i] != Kind::Walker) continue;
+
+            // Only the tile cells under the enemy are looked up, so the cost per enemy
+            // does not depend on the level size
+            if (auto tile_bounds = tilemap.find_solid_overlap(get_bounds(i))) {
+                // Hit a wall, turn around and move away from it
+                m_directions[i] *= -1.0f;
+                if (m_directions[i] > 0) {
+                    m_positions[i].x = tile_bounds->position.x + tile_bounds->size.x + 1.0f;
+                } else {
+                    m_positions[i].x = tile_bounds->position.x - SIZE.x - 1.0f;
+                }
+            }
+        }
+    }
+
+    std::optional<size_t> EnemyStore::find_overlap(const sf::FloatRect& area) const {
+        for (size_t i = 0; i < m_positions.size(); ++i) {
+            if (area.findIntersection(get_bounds(i))) {
+                return i;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void EnemyStore::render(core::SpriteBatch& batch, float alpha) const {
+        for (size_t i = 0; i < m_positions.size(); ++i) {
+            sf::Vector2f position = m_previous_positions[i] + (m_positions[i] - m_previous_positions[i]) * alpha;
+            sf::FloatRect bounds(position, SIZE);
+
+            if (m_kinds[i] == Kind::Walker) {
+                // Walkers face their direction of travel
+                batch.add(m_walker_frames[m_frames[i]], bounds, m_directions[i] < 0);
+            } else {
+                batch.add(m_flyer_frames[m_frames[i]], bounds);
+            }
+        }
+    }
+
+} // namespace entities
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "../core/ResourceManager.hpp"
+#include "../core/SpriteBatch.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace world {
+    class TileMap;
+}
+
+namespace entities {
+
+    // Every live enemy of a World, stored as parallel arrays (one element per enemy) rather
+    // than one heap object each. Updates are plain loops over the arrays, one pass per
+    // concern, so thousands of enemies stay cache-friendly and need no virtual calls.
+    // Removal swaps the last enemy into the hole, so indices are only stable between removals.
+    class EnemyStore {
+    public:
+        enum class Kind : std::uint8_t {
+            Walker, // Patrols left/right, turns at walls
+            Flyer   // Bobs up and down around its spawn height
+        };
+
+        explicit EnemyStore(std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+        // Adds an enemy at `position`; spawn_id is the caller's handle (World's spawn index)
+        void spawn(Kind kind, const sf::Vector2f& position, std::uint32_t spawn_id);
+        void remove(size_t index);
+        void clear();
+        void reserve(size_t count);
+
+        void begin_step(); // Snapshot positions for render interpolation
+        void update(float dt);
+        // Walkers touching a solid tile turn around and step out of it
+        void resolve_walls(const world::TileMap& tilemap);
+        void render(core::SpriteBatch& batch, float alpha) const;
+
+        // Index of the first enemy overlapping `area`, if any
+        [[nodiscard]] std::optional<size_t> find_overlap(const sf::FloatRect& area) const;
+        [[nodiscard]] sf::FloatRect get_bounds(size_t index) const { return sf::FloatRect(m_positions[index], SIZE); }
+
+        [[nodiscard]] size_t size() const { return m_positions.size(); }
+        [[nodiscard]] size_t count(Kind kind) const;
+        [[nodiscard]] std::span<const sf::Vector2f> get_positions() const { return m_positions; }
+        [[nodiscard]] std::span<const std::uint32_t> get_spawn_ids() const { return m_spawn_ids; }
+
+        static constexpr sf::Vector2f SIZE{32.0f, 32.0f};
+
+    private:
+        // Per-enemy components, all indexed the same way
+        std::pmr::vector<Kind> m_kinds;
+        std::pmr::vector<sf::Vector2f> m_positions;
+        std::pmr::vector<sf::Vector2f> m_previous_positions;
+        std::pmr::vector<sf::Vector2f> m_velocities;
+        std::pmr::vector<float> m_directions;       // Walkers: 1.0 = right, -1.0 = left
+        std::pmr::vector<float> m_anchor_y;         // Flyers: centre of the bobbing motion
+        std::pmr::vector<float> m_flight_time;      // Flyers: time since spawn, drives the bobbing
+        std::pmr::vector<float> m_animation_timers;
+        std::pmr::vector<std::uint8_t> m_frames;    // 0 or 1
+        std::pmr::vector<std::uint32_t> m_spawn_ids;
+
+        // Animation frames shared by every enemy of a kind, stretched over the hitbox
+        core::TextureRegion m_walker_frames[2];
+        core::TextureRegion m_flyer_frames[2];
+
+        static constexpr float WALK_SPEED = 80.0f;
+        static constexpr float FLY_AMPLITUDE = 64.0f; // Vertical range (2 tiles up/down)
+        static constexpr float FLY_SPEED = 2.0f;      // Oscillation speed
+        static constexpr float ANIMATION_SPEED = 0.15f;
+    };
+
+} // namespace entities
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
-#include "../core/GameWindow.hpp"
+#include "../core/SpriteBatch.hpp"
 
 namespace entities {
 
@@ -11,7 +11,8 @@ namespace entities {
         virtual ~Entity() = default;
 
         virtual void update(float dt) = 0;
-        virtual void render(core::GameWindow& window) = 0;
+        // alpha in [0, 1] blends from the previous simulation step to the current one
+        virtual void render(core::SpriteBatch& batch, float alpha) = 0;
 
         sf::FloatRect get_bounds() const;
         sf::Vector2f get_position() const { return m_position; }
@@ -19,9 +20,16 @@ namespace entities {
         
         void set_position(const sf::Vector2f& pos) { m_position = pos; }
         void set_velocity(const sf::Vector2f& vel) { m_velocity = vel; }
+        
+        // Called at the start of every simulation step, before anything moves
+        void begin_step() { m_previous_position = m_position; }
+        sf::Vector2f get_render_position(float alpha) const {
+            return m_previous_position + (m_position - m_previous_position) * alpha;
+        }
 
     protected:
         sf::Vector2f m_position;
+        sf::Vector2f m_previous_position; // Position at the start of the current step
         sf::Vector2f m_velocity;
         sf::Vector2f m_size;
     };
@@ -3,9 +3,7 @@
 #include "../core/SkinManager.hpp"
 #include <iostream>
 #include <cmath>
-#include <filesystem>
 #include <string>
-#include <SFML/Audio.hpp>
 
 namespace entities {
 
@@ -17,45 +15,27 @@ namespace entities {
           m_prev_state(AnimationState::Idle),
           m_animation_timer(0.0f),
           m_facing_right(true),
-          m_walk_frame(0) {
+          m_clip_frame(0) {
         
         // Get selected skin
         std::string skin_id = core::LevelProgress::instance().get_selected_skin();
         const auto& skin_info = core::SkinManager::instance().get_skin(skin_id);
-        m_skin_prefix = skin_info.texture_prefix;
+        const std::string& skin = skin_info.texture_prefix;
         
-        // Load all animation textures with unique keys
+        // Resolve every animation frame once; the per-step update only picks table entries.
+        // Regions come from the atlas; unpacked frames fall back to standalone textures.
         auto& rm = core::ResourceManager::instance();
-        std::string idle_key = "player_" + m_skin_prefix + "_idle";
-        std::string jump_key = "player_" + m_skin_prefix + "_jump";
-        std::string walk_a_key = "player_" + m_skin_prefix + "_walk_a";
-        std::string walk_b_key = "player_" + m_skin_prefix + "_walk_b";
-
-        rm.load_texture(idle_key, "assets/Pack_to_pick/Game/Sprites/Characters/Default/" + m_skin_prefix + "_idle.png");
-        rm.load_texture(jump_key, "assets/Pack_to_pick/Game/Sprites/Characters/Default/" + m_skin_prefix + "_jump.png");
-        rm.load_texture(walk_a_key, "assets/Pack_to_pick/Game/Sprites/Characters/Default/" + m_skin_prefix + "_walk_a.png");
-        rm.load_texture(walk_b_key, "assets/Pack_to_pick/Game/Sprites/Characters/Default/" + m_skin_prefix + "_walk_b.png");
-
-        // Initialize sprite
-        m_sprite.emplace(rm.get_texture(idle_key));
-
-        // Scale sprite to match hitbox size
-        const auto& tex = rm.get_texture(idle_key);
-        sf::Vector2u tex_size = tex.getSize();
-        m_sprite->setScale(sf::Vector2f(m_size.x / tex_size.x, m_size.y / tex_size.y));
+        auto load_frame = [&](const char* frame) {
+            return rm.load_region("player_" + skin + "_" + frame,
+                                  "assets/Pack_to_pick/Game/Sprites/Characters/Default/" + skin + "_" + frame + ".png");
+        };
+        m_clips[static_cast<int>(AnimationState::Idle)] = {{load_frame("idle")}, 1};
+        m_clips[static_cast<int>(AnimationState::Walking)] = {{load_frame("walk_a"), load_frame("walk_b")}, 2};
+        m_clips[static_cast<int>(AnimationState::Jumping)] = {{load_frame("jump")}, 1};
         
-        // Load and init sounds
-        rm.load_sound_buffer("player_jump", "assets/Pack_to_pick/Game/Sounds/sfx_jump.ogg");
-        // Assuming damage.ogg is in assets/sounds/ as requested, if not found, ResourceManager will handle or we should check
-        if (std::filesystem::exists("assets/sounds/damage.ogg")) {
-             rm.load_sound_buffer("player_damage", "assets/sounds/damage.ogg");
-        } else {
-             // Fallback to hurt sound if damage.ogg missing
-             rm.load_sound_buffer("player_damage", "assets/Pack_to_pick/Game/Sounds/sfx_hurt.ogg");
-        }
-        
-        m_jump_sound.emplace(rm.get_sound_buffer("player_jump"));
-        m_damage_sound.emplace(rm.get_sound_buffer("player_damage"));
+        // Sounds are preloaded with the level; this only resolves the handles
+        m_jump_sound = rm.load_sound_id(core::sounds::PLAYER_JUMP);
+        m_damage_sound = rm.load_sound_id(core::sounds::PLAYER_DAMAGE);
     }
 
     void Player::update(float dt) {
@@ -66,17 +46,9 @@ namespace entities {
         m_position += m_velocity * dt;
         
         update_animation(dt);
-        
-        // Update sprite position
-        if (m_sprite) {
-            m_sprite->setPosition(sf::Vector2f(m_position.x + m_size.x / 2.0f, m_position.y)); // Center X, Top Y (origin adjusted in update_animation)
-        }
     }
 
     void Player::update_animation(float dt) {
-        if (!m_sprite) return;
-        auto& rm = core::ResourceManager::instance();
-        
         // Determine state
         AnimationState new_state;
         if (!m_on_ground) {
@@ -92,82 +64,43 @@ namespace entities {
             m_prev_state = m_state;
             m_state = new_state;
             m_animation_timer = 0.0f;
-            m_walk_frame = 0;
+            m_clip_frame = 0;
         }
         
         // Determine facing direction
         if (m_velocity.x > 0) m_facing_right = true;
         else if (m_velocity.x < 0) m_facing_right = false;
         
-        // Update texture based on state
-        std::string idle_key = "player_" + m_skin_prefix + "_idle";
-        std::string jump_key = "player_" + m_skin_prefix + "_jump";
-        std::string walk_a_key = "player_" + m_skin_prefix + "_walk_a";
-        std::string walk_b_key = "player_" + m_skin_prefix + "_walk_b";
-
-        switch (m_state) {
-            case AnimationState::Idle:
-                m_sprite->setTexture(rm.get_texture(idle_key));
-                break;
-                
-            case AnimationState::Jumping:
-                m_sprite->setTexture(rm.get_texture(jump_key));
-                break;
-                
-            case AnimationState::Walking:
-                m_animation_timer += dt;
-                if (m_animation_timer >= ANIMATION_FRAME_TIME) {
-                    m_animation_timer -= ANIMATION_FRAME_TIME; // Subtract instead of reset for consistent timing
-                    m_walk_frame = 1 - m_walk_frame; // Toggle between 0 and 1
-                }
-                
-                if (m_walk_frame == 0) {
-                    m_sprite->setTexture(rm.get_texture(walk_a_key));
-                } else {
-                    m_sprite->setTexture(rm.get_texture(walk_b_key));
-                }
-                break;
-        }
-        
-        // Handle flipping
-        // Reset scale to positive
-        sf::Vector2f scale = m_sprite->getScale();
-        scale.x = std::abs(scale.x);
-        
-        if (!m_facing_right) {
-            scale.x = -scale.x;
-            m_sprite->setOrigin(sf::Vector2f(m_sprite->getTexture().getSize().x / 2.0f, 0.0f));
-            m_sprite->setPosition(sf::Vector2f(m_position.x + m_size.x / 2.0f, m_position.y));
-        } else {
-             m_sprite->setOrigin(sf::Vector2f(m_sprite->getTexture().getSize().x / 2.0f, 0.0f));
-             m_sprite->setPosition(sf::Vector2f(m_position.x + m_size.x / 2.0f, m_position.y));
+        // Advance multi-frame clips (walking); single-frame clips just hold
+        const AnimationClip& clip = m_clips[static_cast<int>(m_state)];
+        if (clip.frame_count > 1) {
+            m_animation_timer += dt;
+            if (m_animation_timer >= ANIMATION_FRAME_TIME) {
+                m_animation_timer -= ANIMATION_FRAME_TIME; // Subtract instead of reset for consistent timing
+                m_clip_frame = (m_clip_frame + 1) % clip.frame_count;
+            }
         }
-        m_sprite->setScale(scale);
     }
 
-    void Player::render(core::GameWindow& window) {
-        if (m_sprite) {
-            window.draw(*m_sprite);
-        }
+    void Player::render(core::SpriteBatch& batch, float alpha) {
+        // Facing left mirrors the frame inside the hitbox
+        const core::TextureRegion& frame = m_clips[static_cast<int>(m_state)].frames[m_clip_frame];
+        batch.add(frame, sf::FloatRect(get_render_position(alpha), m_size), !m_facing_right);
     }
 
     void Player::handle_input() {
         // Horizontal movement
         m_velocity.x = 0.0f;
         
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left) || 
-            sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Q)) {
+        if (m_input.left) {
             m_velocity.x = -MOVE_SPEED;
         }
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right) || 
-            sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D)) {
+        if (m_input.right) {
             m_velocity.x = MOVE_SPEED;
         }
         
         // Jump
-        if ((sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Up) || 
-             sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Z) ||
-             sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Space)) && m_on_ground) {
+        if (m_input.jump && m_on_ground) {
             jump();
         }
     }
@@ -186,19 +119,20 @@ namespace entities {
     void Player::jump() {
         m_velocity.y = JUMP_VELOCITY;
         m_on_ground = false;
-        if (m_jump_sound) m_jump_sound->play();
+        core::ResourceManager::instance().play_sound(m_jump_sound);
     }
 
     void Player::take_damage() {
         if (m_lives > 0) {
             m_lives--;
-            if (m_damage_sound) m_damage_sound->play();
+            core::ResourceManager::instance().play_sound(m_damage_sound);
             std::cout << "Player took damage! Lives remaining: " << m_lives << std::endl;
         }
     }
 
     void Player::reset_to_checkpoint(const sf::Vector2f& checkpoint_pos) {
         m_position = checkpoint_pos;
+        m_previous_position = checkpoint_pos; // Teleport, don't interpolate across the level
         m_velocity = sf::Vector2f(0.0f, 0.0f);
         m_on_ground = false;
     }
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "Entity.hpp"
+#include "PlayerInput.hpp"
 #include "../core/ResourceManager.hpp"
+#include <array>
 #include <optional>
 #include <string>
 
@@ -13,8 +15,9 @@ namespace entities {
         ~Player() override = default;
 
         void update(float dt) override;
-        void render(core::GameWindow& window) override;
+        void render(core::SpriteBatch& batch, float alpha) override;
 
+        void set_input(const PlayerInput& input) { m_input = input; }
         void handle_input();
         void apply_gravity(float dt);
         void jump();
@@ -34,7 +37,7 @@ namespace entities {
         };
 
     private:
-        std::optional<sf::Sprite> m_sprite;
+        PlayerInput m_input;
         bool m_on_ground;
         int m_lives;
         
@@ -43,11 +46,18 @@ namespace entities {
         AnimationState m_prev_state; // Track previous state for smoother transitions
         float m_animation_timer;
         bool m_facing_right;
-        int m_walk_frame; // 0 or 1 for walk_a / walk_b
-        std::string m_skin_prefix;
+        int m_clip_frame; // Frame within the clip of m_state
         
-        std::optional<sf::Sound> m_jump_sound;
-        std::optional<sf::Sound> m_damage_sound;
+        // Frames of one animation state, resolved from the skin at construction
+        struct AnimationClip {
+            std::array<core::TextureRegion, 2> frames;
+            int frame_count = 1;
+        };
+        std::array<AnimationClip, 3> m_clips; // Indexed by AnimationState
+        
+        // Shared buffers from core::sounds; playing one never builds a per-player sf::Sound
+        core::SoundId m_jump_sound;
+        core::SoundId m_damage_sound;
         
         void update_animation(float dt);
         
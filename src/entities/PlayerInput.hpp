@@ -0,0 +1,34 @@
+#pragma once
+
+#include <SFML/Window.hpp>
+#include <cstdint>
+
+namespace entities {
+
+    // Buttons held during one simulation step. The player only reads this, so the game feeds it
+    // from the keyboard while headless runs and replays feed it from a script or a recording.
+    struct PlayerInput {
+        bool left = false;
+        bool right = false;
+        bool jump = false;
+
+        // Packed form used by replays: bit 0 left, bit 1 right, bit 2 jump
+        std::uint8_t to_bits() const {
+            return static_cast<std::uint8_t>((left ? 1 : 0) | (right ? 2 : 0) | (jump ? 4 : 0));
+        }
+        static PlayerInput from_bits(std::uint8_t bits) {
+            return PlayerInput{(bits & 1) != 0, (bits & 2) != 0, (bits & 4) != 0};
+        }
+
+        static PlayerInput from_keyboard() {
+            using Key = sf::Keyboard::Key;
+            PlayerInput input;
+            input.left = sf::Keyboard::isKeyPressed(Key::Left) || sf::Keyboard::isKeyPressed(Key::Q);
+            input.right = sf::Keyboard::isKeyPressed(Key::Right) || sf::Keyboard::isKeyPressed(Key::D);
+            input.jump = sf::Keyboard::isKeyPressed(Key::Up) || sf::Keyboard::isKeyPressed(Key::Z) ||
+                         sf::Keyboard::isKeyPressed(Key::Space);
+            return input;
+        }
+    };
+
+} // namespace entities
@@ -1,34 +1,54 @@
 #include "core/GameWindow.hpp"
 #include "core/ResourceManager.hpp"
+#include "core/AtlasManifest.hpp"
+#include "core/FixedTimestep.hpp"
 #include "states/StateManager.hpp"
 #include "states/MainMenuState.hpp"
 #include <iostream>
+#include <string>
 
-int main() {
+int main(int argc, char* argv[]) {
     std::cout << "Starting PlatformProjectCPP_Esimed..." << std::endl;
 
+    // Simulation rate, e.g. --tick-rate 60. Rendering runs at whatever rate the machine manages.
+    core::FixedTimestep timestep;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "--tick-rate") {
+            try {
+                timestep.set_tick_rate(std::stof(argv[i + 1]));
+            } catch (const std::exception&) {
+                std::cerr << "[WARNING] Ignoring invalid --tick-rate value: " << argv[i + 1] << std::endl;
+            }
+        }
+    }
+    std::cout << "Simulation tick rate: " << timestep.get_tick_rate() << " Hz" << std::endl;
+
     // Initialize Window
     core::GameWindow window(1280, 720, "Terraquest Platformer");
 
+    // Pack gameplay sprites into atlas pages (uploading them needs the window's GL context)
+    core::register_atlas_sprites(core::ResourceManager::instance());
+    core::ResourceManager::instance().build_atlases();
+
     // Initialize State Manager
     states::StateManager state_manager(window);
     state_manager.push_state(std::make_unique<states::MainMenuState>(state_manager));
 
-    // Clock for dt
+    // Clock for frame time
     sf::Clock clock;
 
     // Game Loop
     while (window.is_open()) {
-        // Calculate Delta Time
-        sf::Time dt_time = clock.restart();
-        float dt = dt_time.asSeconds();
-
         window.poll_events();
         
-        // State Loop
+        // State Loop: the simulation advances in fixed steps, zero or more per frame
         state_manager.handle_input();
-        state_manager.update(dt);
+        int steps = timestep.advance(clock.restart().asSeconds());
+        for (int i = 0; i < steps; ++i) {
+            state_manager.update(timestep.get_step());
+        }
         state_manager.process_state_changes();
+        state_manager.set_interpolation_alpha(timestep.get_alpha());
 
         window.clear();
         state_manager.draw();
@@ -5,6 +5,7 @@
 #include "../core/GameWindow.hpp"
 #include "../core/CustomLevelManager.hpp"
 #include <iostream>
+#include <random>
 
 namespace states {
 
@@ -59,6 +60,23 @@ namespace states {
         });
         m_buttons.push_back(std::move(new_btn));
 
+        // "Generate" Button: a random level saved straight into the list
+        auto generate_btn = std::make_unique<ui::UIButton>(
+            sf::Vector2f{1280.0f / 2.0f + 170.0f, 140.0f}, 
+            sf::Vector2f{220.f, 60.f}, 
+            "GENERER", 
+            "button_blue_rect", 
+            "tap_sound", 
+            font
+        );
+        generate_btn->set_callback([this]() {
+            core::LevelGeneratorSettings settings;
+            settings.seed = std::random_device{}();
+            core::CustomLevelManager::instance().add_generated_level(settings);
+            refresh_level_list();
+        });
+        m_buttons.push_back(std::move(generate_btn));
+
         // Back Button
         auto back_btn = std::make_unique<ui::UIButton>(
             sf::Vector2f{50.0f, 650.0f}, 
@@ -12,36 +12,84 @@ namespace states {
     GameState::GameState(StateManager& state_manager, const std::string& custom_data, bool is_test_mode)
         : m_state_manager(state_manager), m_level_id(-1), m_custom_data(custom_data), m_is_test_mode(is_test_mode) {}
 
+    GameState::GameState(StateManager& state_manager, const core::CustomLevelInfo& custom_level)
+        : m_state_manager(state_manager), m_level_id(-1), m_custom_level_id(custom_level.id), m_is_test_mode(false) {}
+
+    namespace {
+        struct AssetEntry {
+            const char* name;
+            const char* path;
+        };
+
+        // HUD and end-of-level menu assets. Hearts are packed in the sprite atlas; the loader
+        // skips anything already loaded, so they only come from disk without an atlas.
+        constexpr AssetEntry HUD_TEXTURES[] = {
+            {"player_idle", "assets/gameplay/player_idle.png"},
+            {"enemy_slime", "assets/gameplay/enemy_slime.png"},
+            {"life_full", "assets/Pack_to_pick/Game/Sprites/Tiles/Default/hud_heart.png"},
+            {"life_empty", "assets/Pack_to_pick/Game/Sprites/Tiles/Default/hud_heart_empty.png"},
+            {"coin_icon", "assets/gameplay/items/coin_gold.png"},
+            {"panel_blue", "assets/ui/panel_blue.png"},
+            {"btn_blue", "assets/Pack_to_pick/UI/PNG/Blue/Default/button_rectangle_depth_gloss.png"},
+            {"icon_repeat", "assets/Pack_to_pick/UI/PNG/Extra/Default/icon_repeat_light.png"},
+            {"icon_play", "assets/Pack_to_pick/UI/PNG/Extra/Default/icon_play_light.png"},
+            {"divider", "assets/Pack_to_pick/UI/PNG/Extra/Default/divider.png"},
+            {"star_filled", "assets/Pack_to_pick/UI/PNG/Blue/Default/star.png"},
+            {"star_empty", "assets/Pack_to_pick/UI/PNG/Blue/Default/star_outline.png"},
+        };
+    }
+
     void GameState::init() {
         std::cout << "Initializing GameState for Level " << m_level_id << std::endl;
         
-        // Preload textures
-        core::ResourceManager::instance().load_texture("player_idle", "assets/gameplay/player_idle.png");
-        core::ResourceManager::instance().load_texture("enemy_slime", "assets/gameplay/enemy_slime.png");
+        // The font is needed right away for the loading screen
+        auto& font = core::ResourceManager::instance().load_font("cosmic_font", "assets/menu/font_cosmic.ttf");
         
-        // Load UI textures - using heart sprites
-        auto& life_full_tex = core::ResourceManager::instance().load_texture("life_full", "assets/Pack_to_pick/Game/Sprites/Tiles/Default/hud_heart.png");
-        auto& life_empty_tex = core::ResourceManager::instance().load_texture("life_empty", "assets/Pack_to_pick/Game/Sprites/Tiles/Default/hud_heart_empty.png");
-        auto& panel_tex = core::ResourceManager::instance().load_texture("panel_blue", "assets/ui/panel_blue.png");
+        // Setup HUD text
+        m_status_text = sf::Text(font);
+        m_status_text->setCharacterSize(36);
+        m_status_text->setFillColor(sf::Color::White);
+        // Position will be set in draw
         
-        // Load NEW UI textures for improved menus
-        core::ResourceManager::instance().load_texture("btn_blue", "assets/Pack_to_pick/UI/PNG/Blue/Default/button_rectangle_depth_gloss.png");
-        core::ResourceManager::instance().load_texture("icon_repeat", "assets/Pack_to_pick/UI/PNG/Extra/Default/icon_repeat_light.png");
-        core::ResourceManager::instance().load_texture("icon_play", "assets/Pack_to_pick/UI/PNG/Extra/Default/icon_play_light.png");
-        core::ResourceManager::instance().load_texture("divider", "assets/Pack_to_pick/UI/PNG/Extra/Default/divider.png");
-        core::ResourceManager::instance().load_texture("star_filled", "assets/Pack_to_pick/UI/PNG/Blue/Default/star.png");
-        core::ResourceManager::instance().load_texture("star_empty", "assets/Pack_to_pick/UI/PNG/Blue/Default/star_outline.png");
+        begin_loading();
+    }
+
+    void GameState::begin_loading() {
+        // Everything else is decoded in the background; update() builds the HUD and the
+        // World once it is all in, and draw() shows progress until then
+        auto& rm = core::ResourceManager::instance();
+        // Runs from button callbacks, after the button started its click
+        rm.stop_all_sounds(rm.load_sound_id(core::sounds::BUTTON_CLICK));
+        m_world.reset();
+        m_loader = std::make_unique<core::AssetLoader>();
+        if (!m_hud_ready) {
+            for (const auto& texture : HUD_TEXTURES) m_loader->queue_texture(rm, texture.name, texture.path);
+        }
+        world::World::queue_assets(*m_loader, is_custom_level() ? -1 : m_level_id);
+    }
+
+    void GameState::setup_hud() {
+        // All of these were loaded by the AssetLoader, so the calls below are cache hits
+        auto& rm = core::ResourceManager::instance();
+        m_life_full_id = rm.get_texture_id("life_full");
+        m_life_empty_id = rm.get_texture_id("life_empty");
+        m_coin_icon_id = rm.get_texture_id("coin_icon");
+        m_star_filled_id = rm.get_texture_id("star_filled");
+        m_star_empty_id = rm.get_texture_id("star_empty");
+        // The menu button plays this by name; resolving the manifest entry applies its priority and cap
+        rm.load_sound_id(core::sounds::BUTTON_CLICK);
+        const core::TextureRegion& life_full = rm.get_region(m_life_full_id);
         
         // Setup life sprites (3 lives max)
         for (int i = 0; i < 3; ++i) {
-            sf::Sprite life_sprite(life_full_tex);
+            sf::Sprite life_sprite(*life_full.texture, life_full.rect);
             life_sprite.setScale(sf::Vector2f(0.5f, 0.5f)); // Scale down stars
             life_sprite.setPosition(sf::Vector2f(10.0f + i * 40.0f, 10.0f));
             m_life_sprites.push_back(life_sprite);
         }
         
         // Setup panel for game over/victory (centered) - make it bigger
-        m_panel_sprite = sf::Sprite(panel_tex);
+        m_panel_sprite = sf::Sprite(rm.get_texture("panel_blue"));
         m_panel_sprite->setScale({5.0f, 4.5f}); 
         // Center panel dynamically
         sf::FloatRect bounds = m_panel_sprite->getLocalBounds();
@@ -49,43 +97,77 @@ namespace states {
         m_panel_sprite->setPosition({1280.0f / 2.0f, 720.0f / 2.0f});
         
         // Setup divider sprite
-        auto& divider_tex = core::ResourceManager::instance().get_texture("divider");
+        auto& divider_tex = rm.get_texture("divider");
         m_divider_sprite = sf::Sprite(divider_tex);
         m_divider_sprite->setScale({5.0f, 2.0f});
         sf::FloatRect div_bounds = m_divider_sprite->getLocalBounds();
         m_divider_sprite->setOrigin({div_bounds.size.x / 2.0f, div_bounds.size.y / 2.0f});
         m_divider_sprite->setPosition({1280.0f / 2.0f, 330.0f});
         
-        // Load font for HUD
-        auto& font = core::ResourceManager::instance().load_font("cosmic_font", "assets/menu/font_cosmic.ttf");
+        m_hud_ready = true;
+    }
+
+    void GameState::draw_loading_screen(core::GameWindow& window) {
+        window.get_sf_window().setView(window.get_sf_window().getDefaultView());
         
-        // Setup HUD text
-        m_status_text = sf::Text(font);
-        m_status_text->setCharacterSize(36);
-        m_status_text->setFillColor(sf::Color::White);
-        // Position will be set in draw
+        const sf::Vector2f bar_size(400.0f, 24.0f);
+        const sf::Vector2f bar_pos(1280.0f / 2.0f - bar_size.x / 2.0f, 720.0f / 2.0f);
         
-        // Load sounds - NEW SOUND ASSETS
-        if (!m_jump_buffer.loadFromFile("assets/Pack_to_pick/Game/Sounds/sfx_jump.ogg")) {
-            std::cerr << "Failed to load jump sound" << std::endl;
-        }
-        if (!m_damage_buffer.loadFromFile("assets/Pack_to_pick/Game/Sounds/sfx_bump.ogg")) {
-            std::cerr << "Failed to load damage sound" << std::endl;
-        }
-        if (!m_victory_buffer.loadFromFile("assets/sounds/victory.ogg")) {
-            std::cerr << "Failed to load victory sound" << std::endl;
+        sf::RectangleShape frame(bar_size);
+        frame.setPosition(bar_pos);
+        frame.setFillColor(sf::Color(0, 0, 0, 120));
+        frame.setOutlineColor(sf::Color::White);
+        frame.setOutlineThickness(2.0f);
+        window.draw(frame);
+        
+        sf::RectangleShape fill({bar_size.x * m_loader->get_progress(), bar_size.y});
+        fill.setPosition(bar_pos);
+        fill.setFillColor(sf::Color::Yellow);
+        window.draw(fill);
+        
+        if (m_status_text) {
+            m_status_text->setString("Loading...");
+            m_status_text->setCharacterSize(36);
+            m_status_text->setFillColor(sf::Color::White);
+            sf::FloatRect text_bounds = m_status_text->getLocalBounds();
+            m_status_text->setOrigin({text_bounds.position.x + text_bounds.size.x / 2.0f, text_bounds.position.y + text_bounds.size.y});
+            m_status_text->setPosition({1280.0f / 2.0f, bar_pos.y - 20.0f});
+            window.draw(*m_status_text);
         }
+    }
+
+    void GameState::load_world() {
+        // Retries and level changes drop the old level's memory in one go and rebuild
+        // the new one in the same block; nothing from the old level keeps playing (but the
+        // click of the Retry / Next Level button does)
+        auto& rm = core::ResourceManager::instance();
+        rm.stop_all_sounds(rm.load_sound_id(core::sounds::BUTTON_CLICK));
+        m_world.reset();
+        m_level_arena.reset();
         
-        m_jump_sound = sf::Sound(m_jump_buffer);
-        m_damage_sound = sf::Sound(m_damage_buffer);
-        m_victory_sound = sf::Sound(m_victory_buffer);
+        // Saved custom levels are mapped from their compiled file; only levels without one
+        // (saved before compiling existed) read the text into memory
+        if (m_custom_level_id >= 0 && !m_compiled_level && m_custom_data.empty()) {
+            auto& levels = core::CustomLevelManager::instance();
+            std::filesystem::path compiled_path = levels.get_compiled_path(m_custom_level_id);
+            if (std::filesystem::exists(compiled_path)) {
+                m_compiled_level = world::CompiledLevel::open(compiled_path);
+            }
+            if (!m_compiled_level) {
+                if (auto custom_level = levels.get_level(m_custom_level_id)) m_custom_data = custom_level->data;
+            }
+        }
         
-        // Create world - use custom data if available, otherwise use level_id
-        if (!m_custom_data.empty()) {
-            m_world = std::make_unique<world::World>(m_custom_data);
+        if (m_compiled_level) {
+            m_world = std::make_unique<world::World>(m_compiled_level->view(), -1, m_level_arena.resource());
+        } else if (!m_custom_data.empty()) {
+            m_world = std::make_unique<world::World>(m_custom_data, m_level_arena.resource());
         } else {
-            m_world = std::make_unique<world::World>(m_level_id);
+            m_world = std::make_unique<world::World>(m_level_id, m_level_arena.resource());
         }
+        
+        // Every run is recorded; the step length is filled in by the first update
+        m_replay.begin(is_custom_level() ? -1 : m_level_id, m_custom_data, 0.0f);
     }
 
     void GameState::create_menu_button(bool is_victory) {
@@ -112,7 +194,7 @@ namespace states {
         sf::Vector2f btn_pos(1280.0f / 2.0f - btn_size.x / 2.0f, 400.0f);
         
         m_action_button = std::make_unique<ui::UIButton>(
-            btn_pos, btn_size, label, "btn_blue", "click", font
+            btn_pos, btn_size, label, "btn_blue", std::string(core::sounds::BUTTON_CLICK.name.text), font
         );
         
         // Set icon
@@ -124,19 +206,15 @@ namespace states {
             if (is_victory && m_level_id > 0 && m_level_id < 5) {
                 // Advance to next level
                 m_level_id++;
-                m_world = std::make_unique<world::World>(m_level_id);
+                begin_loading();
                 m_action_button.reset();
                 m_menu_shown = false;
-            } else if (is_victory && (m_level_id >= 5 || !m_custom_data.empty())) {
+            } else if (is_victory && (m_level_id >= 5 || is_custom_level())) {
                 // Return to menu
                 m_state_manager.pop_state();
             } else {
                 // Restart current level
-                if (!m_custom_data.empty()) {
-                    m_world = std::make_unique<world::World>(m_custom_data);
-                } else {
-                    m_world = std::make_unique<world::World>(m_level_id);
-                }
+                load_world();
                 m_action_button.reset();
                 m_menu_shown = false;
             }
@@ -148,30 +226,31 @@ namespace states {
             m_state_manager.pop_state();
         }
         
+        // Toggle debug overlay on key press (not while held)
+        bool debug_pressed = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::F3);
+        if (debug_pressed && !m_was_debug_pressed) {
+            m_show_debug = !m_show_debug;
+        }
+        m_was_debug_pressed = debug_pressed;
+        
         // Handle restart or level progression for keyboard
         if (m_world && (m_world->is_game_over() || m_world->is_level_complete())) {
             if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::R)) {
                 if (m_world->is_level_complete() && m_level_id > 0 && m_level_id < 5) {
                     // Advance to next level (only for standard levels)
                     m_level_id++;
-                    m_world = std::make_unique<world::World>(m_level_id);
+                    begin_loading();
                     m_action_button.reset();
                     m_menu_shown = false;
                 } else if (m_world->is_level_complete() && m_level_id >= 5) {
                     // Return to main menu after last level
                     m_state_manager.pop_state();
-                } else if (m_world->is_level_complete() && !m_custom_data.empty()) {
+                } else if (m_world->is_level_complete() && is_custom_level()) {
                     // Custom level completed - return to editor
                     m_state_manager.pop_state();
                 } else {
                     // Restart current level on game over
-                    if (!m_custom_data.empty()) {
-                        // Replay custom level
-                        m_world = std::make_unique<world::World>(m_custom_data);
-                    } else {
-                        // Replay standard level
-                        m_world = std::make_unique<world::World>(m_level_id);
-                    }
+                    load_world();
                     m_action_button.reset();
                     m_menu_shown = false;
                 }
@@ -180,12 +259,45 @@ namespace states {
     }
 
     void GameState::update(float dt) {
+        if (m_loader) {
+            m_loader->poll(core::ResourceManager::instance());
+            if (!m_loader->is_done()) return;
+            
+            m_loader.reset();
+            if (!m_hud_ready) setup_hud();
+            load_world();
+            return;
+        }
+        
         if (m_world) {
             // Check if level just completed and save stars
             bool was_complete = m_world->is_level_complete();
             
+            entities::PlayerInput input = entities::PlayerInput::from_keyboard();
+            if (!was_complete && !m_world->is_game_over()) {
+                if (m_replay.get_tick_count() == 0) {
+                    m_replay.set_step(dt);
+                }
+                m_replay.record(input);
+            }
+            m_world->set_player_input(input);
             m_world->update(dt);
             
+            // Run just ended: keep its replay so it can be reproduced (headless_sim --replay)
+            if (!m_replay.is_finished() && (m_world->is_level_complete() || m_world->is_game_over())) {
+                m_replay.finish(m_world->compute_state_hash());
+                // Replays carry the level text; a mapped level only reads it now
+                if (m_compiled_level) {
+                    if (auto custom_level = core::CustomLevelManager::instance().get_level(m_custom_level_id)) {
+                        m_replay.set_level_data(custom_level->data);
+                    }
+                }
+                if (m_replay.save(world::Replay::DEFAULT_PATH)) {
+                    std::cout << "Replay saved to " << world::Replay::DEFAULT_PATH << " ("
+                              << m_replay.get_tick_count() << " ticks)" << std::endl;
+                }
+            }
+            
             // If level just became complete, save stars immediately
             if (!was_complete && m_world->is_level_complete()) {
                 int coins = m_world->get_coins_collected();
@@ -218,29 +330,37 @@ namespace states {
         m_mouse_pos = window.get_sf_window().mapPixelToCoords(mouse_pix, window.get_sf_window().getDefaultView());
         m_mouse_pressed = sf::Mouse::isButtonPressed(sf::Mouse::Button::Left);
         
+        if (m_loader) {
+            draw_loading_screen(window);
+            return;
+        }
+        
         if (m_world) {
             // Set camera view for world rendering
-            window.get_sf_window().setView(m_world->get_camera());
-            m_world->render(window);
+            float alpha = m_state_manager.get_interpolation_alpha();
+            window.get_sf_window().setView(m_world->get_render_camera(alpha));
+            m_world->render(window, alpha);
             
             // Reset to default view for HUD
             window.get_sf_window().setView(window.get_sf_window().getDefaultView());
             
             // Draw lives as hearts
-            auto& life_full_tex = core::ResourceManager::instance().get_texture("life_full");
-            auto& life_empty_tex = core::ResourceManager::instance().get_texture("life_empty");
+            auto& rm = core::ResourceManager::instance();
+            const core::TextureRegion& life_full = rm.get_region(m_life_full_id);
+            const core::TextureRegion& life_empty = rm.get_region(m_life_empty_id);
             
             int lives = m_world->get_player_lives();
             for (int i = 0; i < 3; ++i) {
-                sf::Sprite heart_sprite(i < lives ? life_full_tex : life_empty_tex);
+                const core::TextureRegion& heart = i < lives ? life_full : life_empty;
+                sf::Sprite heart_sprite(*heart.texture, heart.rect);
                 heart_sprite.setScale({0.7f, 0.7f}); // Larger hearts
                 heart_sprite.setPosition({10.0f + i * 40.0f, 10.0f}); // More spacing
                 window.draw(heart_sprite);
             }
             
             // Draw coin counter in top-right
-            auto& coin_tex = core::ResourceManager::instance().load_texture("coin_icon", "assets/gameplay/items/coin_gold.png");
-            sf::Sprite coin_sprite(coin_tex);
+            const core::TextureRegion& coin_icon = rm.get_region(m_coin_icon_id);
+            sf::Sprite coin_sprite(*coin_icon.texture, coin_icon.rect);
             coin_sprite.setScale({0.4f, 0.4f});
             coin_sprite.setPosition({700.0f, 10.0f});
             window.draw(coin_sprite);
@@ -255,6 +375,15 @@ namespace states {
                 window.draw(*m_status_text);
             }
             
+            if (m_show_debug && m_status_text) {
+                sf::Text debug_text(m_status_text->getFont());
+                debug_text.setCharacterSize(16);
+                debug_text.setFillColor(sf::Color::White);
+                debug_text.setString("Draw calls: " + std::to_string(window.get_draw_calls()));
+                debug_text.setPosition({10.0f, 570.0f});
+                window.draw(debug_text);
+            }
+            
             // Show game over or victory message with panel
             if (m_status_text && m_panel_sprite) {
                 if (m_world->is_game_over()) {
@@ -332,8 +461,8 @@ namespace states {
                     int player_lives = m_world->get_player_lives();
                     int stars = core::LevelProgress::instance().calculate_stars(coins, total_coins, player_lives);
                     
-                    auto& star_filled = core::ResourceManager::instance().get_texture("star_filled");
-                    auto& star_empty = core::ResourceManager::instance().get_texture("star_empty");
+                    const core::TextureRegion& star_filled = rm.get_region(m_star_filled_id);
+                    const core::TextureRegion& star_empty = rm.get_region(m_star_empty_id);
                     
                     float star_scale = 0.7f;
                     float star_spacing = 50.0f;
@@ -341,7 +470,8 @@ namespace states {
                     float star_y = 340.0f;
                     
                     for (int i = 0; i < 3; ++i) {
-                        sf::Sprite star_sprite(i < stars ? star_filled : star_empty);
+                        const core::TextureRegion& star = i < stars ? star_filled : star_empty;
+                        sf::Sprite star_sprite(*star.texture, star.rect);
                         star_sprite.setScale({star_scale, star_scale});
                         sf::FloatRect star_bounds = star_sprite.getLocalBounds();
                         star_sprite.setOrigin({star_bounds.size.x / 2.0f, star_bounds.size.y / 2.0f});
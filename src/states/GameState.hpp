@@ -3,7 +3,12 @@
 #include "State.hpp"
 #include "StateManager.hpp"
 #include "../core/GameWindow.hpp"
+#include "../core/AssetLoader.hpp"
+#include "../core/LevelArena.hpp"
 #include "../world/World.hpp"
+#include "../world/Replay.hpp"
+#include "../world/CompiledLevel.hpp"
+#include "../core/CustomLevelManager.hpp"
 #include "../ui/UIButton.hpp"
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
@@ -14,6 +19,8 @@ namespace states {
     public:
         GameState(StateManager& state_manager, int level_id);
         GameState(StateManager& state_manager, const std::string& custom_data, bool is_test_mode);  // For custom levels
+        // Saved custom level, played from its compiled file (text only when there is none)
+        GameState(StateManager& state_manager, const core::CustomLevelInfo& custom_level);
         ~GameState() override = default;
 
         void init() override;
@@ -22,13 +29,25 @@ namespace states {
         void draw(core::GameWindow& window) override;
 
     private:
+        void load_world();
+        [[nodiscard]] bool is_custom_level() const { return !m_custom_data.empty() || m_custom_level_id >= 0; }
+        void begin_loading(); // Queues this level's assets; the world is built once they are in
+        void setup_hud();
+        void draw_loading_screen(core::GameWindow& window);
         void create_menu_button(bool is_victory);
         
         StateManager& m_state_manager;
         int m_level_id;
         std::string m_custom_data;
+        int m_custom_level_id = -1; // Saved custom level, see m_compiled_level
+        // Mapped once per GameState; retries rebuild the World from the same mapping
+        std::optional<world::CompiledLevel> m_compiled_level;
         bool m_is_test_mode = false;
+        core::LevelArena m_level_arena; // Backs m_world; declared first so it outlives it
         std::unique_ptr<world::World> m_world;
+        world::Replay m_replay; // Input of the current run
+        std::unique_ptr<core::AssetLoader> m_loader; // Set while a level is loading
+        bool m_hud_ready = false;
         
         // HUD
         std::optional<sf::Text> m_lives_text;
@@ -36,6 +55,12 @@ namespace states {
         std::vector<sf::Sprite> m_life_sprites;
         std::optional<sf::Sprite> m_panel_sprite;
         std::optional<sf::Sprite> m_divider_sprite;
+        // Resolved in init(); draw() only indexes with them
+        core::TextureId m_life_full_id;
+        core::TextureId m_life_empty_id;
+        core::TextureId m_coin_icon_id;
+        core::TextureId m_star_filled_id;
+        core::TextureId m_star_empty_id;
         
         // Menu button
         std::unique_ptr<ui::UIButton> m_action_button;
@@ -43,13 +68,9 @@ namespace states {
         bool m_mouse_pressed = false;
         bool m_menu_shown = false;
         
-        // Audio
-        sf::SoundBuffer m_jump_buffer;
-        sf::SoundBuffer m_damage_buffer;
-        sf::SoundBuffer m_victory_buffer;
-        std::optional<sf::Sound> m_jump_sound;
-        std::optional<sf::Sound> m_damage_sound;
-        std::optional<sf::Sound> m_victory_sound;
+        // Debug overlay (F3): draw calls of the last frame
+        bool m_show_debug = false;
+        bool m_was_debug_pressed = false;
     };
 
 } // namespace states
@@ -448,7 +448,7 @@ namespace states {
             level.name = "Niveau Custom " + std::to_string(level.id);
         } else {
             level.id = m_level_id;
-            auto existing = core::CustomLevelManager::instance().get_level(m_level_id);
+            auto existing = core::CustomLevelManager::instance().get_level_info(m_level_id);
             level.name = existing ? existing->name : ("Niveau Custom " + std::to_string(level.id));
         }
         
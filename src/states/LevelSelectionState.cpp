@@ -41,7 +41,7 @@ namespace states {
         rm.load_texture("button_blue_rect", "assets/Pack_to_pick/UI/PNG/Blue/Default/button_rectangle_depth_flat.png");
         
         // Load Click Sound
-        if (!rm.has_sound_buffer("click_sound")) rm.load_sound_buffer("click_sound", "assets/menu/click.ogg");
+        rm.load_sound_id(core::sounds::BUTTON_CLICK);
 
         auto& font = rm.get_font("cosmic_font");
 
@@ -152,9 +152,10 @@ namespace states {
                 font
             );
             
-            std::string level_data = level.data;
-            btn->set_callback([this, level_data]() {
-                m_state_manager.push_state(std::make_unique<GameState>(m_state_manager, level_data, false));
+            // GameState maps the compiled level itself; the text is never read here
+            core::CustomLevelInfo info = level;
+            btn->set_callback([this, info]() {
+                m_state_manager.push_state(std::make_unique<GameState>(m_state_manager, info));
             });
             
             m_level_buttons.push_back(std::move(btn));
@@ -28,8 +28,8 @@ namespace states {
         // Load Button Texture (Cosmic)
         (void)core::ResourceManager::instance().load_texture("button_cosmic", "assets/menu/button_cosmic.png");
 
-        // Load Click Sound
-        (void)core::ResourceManager::instance().load_sound_buffer("click_sound", "assets/menu/click.ogg");
+        // Load Click Sound (through the manifest entry, so its priority and cap apply)
+        core::ResourceManager::instance().load_sound_id(core::sounds::BUTTON_CLICK);
 
         // Setup Title
         m_title.setFont(font);
@@ -31,7 +31,7 @@ namespace states {
         if (!rm.has_texture("star_full")) rm.load_texture("star_full", "assets/Pack_to_pick/UI/PNG/Yellow/Default/star.png");
         
         // Load Click Sound
-        if (!rm.has_sound_buffer("click_sound")) rm.load_sound_buffer("click_sound", "assets/menu/click.ogg");
+        rm.load_sound_id(core::sounds::BUTTON_CLICK);
         
         // Background
         m_background.emplace(rm.get_texture("menu_bg_clean"));
@@ -30,6 +30,10 @@ namespace states {
         void draw();
 
         [[nodiscard]] core::GameWindow& get_window() { return m_window; }
+        
+        // Fraction of a simulation step left over when drawing, for render interpolation
+        void set_interpolation_alpha(float alpha) { m_interpolation_alpha = alpha; }
+        [[nodiscard]] float get_interpolation_alpha() const { return m_interpolation_alpha; }
 
     private:
         std::stack<std::unique_ptr<State>> m_states;
@@ -39,6 +43,7 @@ namespace states {
         bool m_is_adding = false;
         bool m_is_replacing = false;
         std::unique_ptr<State> m_temp_state;
+        float m_interpolation_alpha = 1.0f;
     };
 
 } // namespace states
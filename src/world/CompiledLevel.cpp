@@ -0,0 +1,162 @@
+#include "CompiledLevel.hpp"
+#include "../core/ResourceId.hpp"
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+#include <type_traits>
+
+namespace world {
+
+    // The tables are used in place, so the in-memory types must match the file records
+    static_assert(std::endian::native == std::endian::little, "compiled levels are little-endian");
+    static_assert(sizeof(TileType) == 1);
+    static_assert(sizeof(sf::Vector2f) == 8 && std::is_trivially_copyable_v<sf::Vector2f>);
+    static_assert(sizeof(SpawnPoint) == 12 && offsetof(SpawnPoint, position) == 4);
+
+    namespace {
+        struct Header {
+            char magic[4];
+            std::uint32_t version;
+            std::int32_t width;
+            std::int32_t height;
+            float spawn_x;
+            float spawn_y;
+            float flag_x;
+            float flag_y;
+            std::uint32_t checkpoint_count;
+            std::uint32_t spawn_count;
+            std::uint32_t coin_count;
+            std::uint32_t reserved;
+            std::uint64_t checksum;
+        };
+        static_assert(sizeof(Header) == 56);
+
+        constexpr float CELL_SIZE = 32.0f; // TileMap::TILE_SIZE
+
+        constexpr size_t align4(size_t size) { return (size + 3) & ~size_t{3}; }
+
+        std::uint64_t checksum(std::span<const std::byte> bytes) {
+            return core::hash_name(std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+        }
+
+        template <typename T>
+        void append(std::vector<std::byte>& out, const T& value) {
+            const auto* bytes = reinterpret_cast<const std::byte*>(&value);
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+    }
+
+    bool CompiledLevel::is_compiled(std::span<const std::byte> bytes) {
+        return bytes.size() >= sizeof(MAGIC) && std::memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) == 0;
+    }
+
+    std::optional<LevelView> CompiledLevel::view_bytes(std::span<const std::byte> bytes) {
+        if (!is_compiled(bytes) || bytes.size() < sizeof(Header)) return std::nullopt;
+        // Mapped files are page aligned; other buffers need at least float alignment
+        if (reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(float) != 0) return std::nullopt;
+
+        Header header;
+        std::memcpy(&header, bytes.data(), sizeof(Header));
+        if (header.version != VERSION || header.width < 0 || header.height < 0) return std::nullopt;
+
+        const size_t tile_count = static_cast<size_t>(header.width) * static_cast<size_t>(header.height);
+        const size_t tiles_offset = sizeof(Header);
+        const size_t checkpoints_offset = tiles_offset + align4(tile_count);
+        const size_t spawns_offset = checkpoints_offset + size_t{header.checkpoint_count} * sizeof(sf::Vector2f);
+        const size_t end = spawns_offset + size_t{header.spawn_count} * sizeof(SpawnPoint);
+        if (end != bytes.size()) return std::nullopt;
+        if (checksum(bytes.subspan(sizeof(Header))) != header.checksum) return std::nullopt;
+
+        LevelView view;
+        view.width = header.width;
+        view.height = header.height;
+        view.spawn_position = {header.spawn_x, header.spawn_y};
+        view.flag_position = {header.flag_x, header.flag_y};
+        view.coin_count = static_cast<int>(header.coin_count);
+        view.tiles = {reinterpret_cast<const TileType*>(bytes.data() + tiles_offset), tile_count};
+        view.checkpoints = {reinterpret_cast<const sf::Vector2f*>(bytes.data() + checkpoints_offset), header.checkpoint_count};
+        view.spawns = {reinterpret_cast<const SpawnPoint*>(bytes.data() + spawns_offset), header.spawn_count};
+
+        // The checksum catches damage, not hand-made files; TileMap indexes tables by tile type
+        for (TileType tile : view.tiles) {
+            if (static_cast<int>(tile) >= TILE_TYPE_COUNT) return std::nullopt;
+        }
+        // World buckets spawns by the chunk under them and sizes its stores from coin_count,
+        // so spawns must lie on the grid (NaN fails these checks too) and the count must match
+        const float level_width = static_cast<float>(header.width) * CELL_SIZE;
+        const float level_height = static_cast<float>(header.height) * CELL_SIZE;
+        size_t coin_spawns = 0;
+        for (const SpawnPoint& spawn : view.spawns) {
+            if (static_cast<int>(spawn.kind) > static_cast<int>(SpawnKind::Coin)) return std::nullopt;
+            if (!(spawn.position.x >= 0.0f && spawn.position.x < level_width)) return std::nullopt;
+            if (!(spawn.position.y >= 0.0f && spawn.position.y < level_height)) return std::nullopt;
+            if (spawn.kind == SpawnKind::Coin) ++coin_spawns;
+        }
+        if (coin_spawns != header.coin_count) return std::nullopt;
+        return view;
+    }
+
+    std::optional<CompiledLevel> CompiledLevel::open(const std::filesystem::path& path) {
+        auto file = core::MappedFile::open(path);
+        if (!file) return std::nullopt;
+
+        auto view = view_bytes(file->bytes());
+        if (!view) {
+            std::cerr << "[ERROR] Not a compiled level (or unsupported version, or corrupt): " << path << std::endl;
+            return std::nullopt;
+        }
+        // Moving the mapping does not move the mapped bytes, so the view stays valid
+        return CompiledLevel(std::move(*file), *view);
+    }
+
+    std::vector<std::byte> compile_level(const LevelView& level) {
+        Header header{};
+        std::memcpy(header.magic, CompiledLevel::MAGIC, sizeof(header.magic));
+        header.version = CompiledLevel::VERSION;
+        header.width = level.width;
+        header.height = level.height;
+        header.spawn_x = level.spawn_position.x;
+        header.spawn_y = level.spawn_position.y;
+        header.flag_x = level.flag_position.x;
+        header.flag_y = level.flag_position.y;
+        header.checkpoint_count = static_cast<std::uint32_t>(level.checkpoints.size());
+        header.spawn_count = static_cast<std::uint32_t>(level.spawns.size());
+        header.coin_count = static_cast<std::uint32_t>(level.coin_count);
+
+        std::vector<std::byte> out(sizeof(Header));
+        out.reserve(sizeof(Header) + align4(level.tiles.size()) + level.checkpoints.size() * sizeof(sf::Vector2f) +
+                    level.spawns.size() * sizeof(SpawnPoint));
+        const auto* tiles = reinterpret_cast<const std::byte*>(level.tiles.data());
+        out.insert(out.end(), tiles, tiles + level.tiles.size());
+        out.resize(sizeof(Header) + align4(level.tiles.size()), std::byte{0});
+        for (const sf::Vector2f& checkpoint : level.checkpoints) {
+            append(out, checkpoint.x);
+            append(out, checkpoint.y);
+        }
+        // Field by field, so the padding bytes are zero and the checksum is reproducible
+        for (const SpawnPoint& spawn : level.spawns) {
+            const std::byte record_head[4] = {static_cast<std::byte>(spawn.kind), {}, {}, {}};
+            out.insert(out.end(), std::begin(record_head), std::end(record_head));
+            append(out, spawn.position.x);
+            append(out, spawn.position.y);
+        }
+
+        header.checksum = checksum(std::span<const std::byte>(out).subspan(sizeof(Header)));
+        std::memcpy(out.data(), &header, sizeof(Header));
+        return out;
+    }
+
+    bool save_compiled_level(const std::filesystem::path& path, const LevelView& level) {
+        std::vector<std::byte> bytes = compile_level(level);
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "[ERROR] Cannot write compiled level: " << path << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return static_cast<bool>(file);
+    }
+
+} // namespace world
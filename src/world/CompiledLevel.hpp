@@ -0,0 +1,47 @@
+#pragma once
+
+#include "LevelParser.hpp"
+#include "../core/MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace world {
+
+    // Binary level format, loaded by mapping the file and pointing a LevelView into it: no
+    // tokenising and no copy of the level before TileMap and World take what they need.
+    //
+    // Layout (little-endian, every table 4-byte aligned):
+    //   Header       56 bytes, see below; checksum is FNV-1a over everything after it
+    //   Tiles        width * height TileType bytes, row-major, zero padded to 4 bytes
+    //   Checkpoints  checkpoint_count x (float x, float y)
+    //   Spawns       spawn_count x (uint8 kind, 3 zero bytes, float x, float y)
+    //
+    // Write with `level_compiler` (tools/) or save_compiled_level().
+    class CompiledLevel {
+    public:
+        // nullopt (and an error on stderr) for unreadable, truncated or corrupt files
+        [[nodiscard]] static std::optional<CompiledLevel> open(const std::filesystem::path& path);
+        // Validates `bytes` and views them in place; they must outlive the returned view
+        [[nodiscard]] static std::optional<LevelView> view_bytes(std::span<const std::byte> bytes);
+        [[nodiscard]] static bool is_compiled(std::span<const std::byte> bytes);
+
+        [[nodiscard]] const LevelView& view() const { return m_view; }
+
+        static constexpr char MAGIC[4] = {'P', 'L', 'V', 'L'};
+        static constexpr std::uint32_t VERSION = 1;
+
+    private:
+        CompiledLevel(core::MappedFile file, const LevelView& view) : m_file(std::move(file)), m_view(view) {}
+
+        core::MappedFile m_file;
+        LevelView m_view; // Points into m_file
+    };
+
+    [[nodiscard]] std::vector<std::byte> compile_level(const LevelView& level);
+    bool save_compiled_level(const std::filesystem::path& path, const LevelView& level);
+
+} // namespace world
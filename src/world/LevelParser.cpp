@@ -0,0 +1,82 @@
+#include "LevelParser.hpp"
+#include <algorithm>
+
+namespace world {
+
+    namespace {
+        constexpr float CELL_SIZE = 32.0f; // TileMap::TILE_SIZE
+
+        // Re-lays the rows written so far at a wider stride. Level lines normally all have
+        // the same length, so this only runs for the first line or ragged custom levels.
+        void widen(LevelDescription& level, int width) {
+            auto& tiles = level.tiles;
+            const size_t old_width = static_cast<size_t>(level.width);
+            const size_t new_width = static_cast<size_t>(width);
+            tiles.resize(new_width * level.height, TileType::EMPTY);
+            for (int row = level.height - 1; row > 0; --row) {
+                auto old_begin = tiles.begin() + static_cast<std::ptrdiff_t>(row * old_width);
+                auto new_begin = tiles.begin() + static_cast<std::ptrdiff_t>(row * new_width);
+                std::move_backward(old_begin, old_begin + static_cast<std::ptrdiff_t>(old_width),
+                                   new_begin + static_cast<std::ptrdiff_t>(old_width));
+                std::fill(old_begin, new_begin, TileType::EMPTY);
+            }
+            level.width = width;
+        }
+    }
+
+    LevelDescription parse_level(std::string_view level_data, std::pmr::memory_resource* memory) {
+        LevelDescription level(memory);
+
+        // Same line splitting as std::getline: a trailing newline does not start a new row
+        size_t line_start = 0;
+        while (line_start < level_data.size()) {
+            size_t line_end = level_data.find('\n', line_start);
+            if (line_end == std::string_view::npos) line_end = level_data.size();
+            std::string_view line = level_data.substr(line_start, line_end - line_start);
+            line_start = line_end + 1;
+
+            const int row = level.height;
+            if (static_cast<int>(line.size()) > level.width) {
+                widen(level, static_cast<int>(line.size()));
+            }
+            level.height++;
+            level.tiles.resize(static_cast<size_t>(level.width) * level.height, TileType::EMPTY);
+            TileType* cells = level.tiles.data() + static_cast<size_t>(row) * level.width;
+
+            for (size_t col = 0; col < line.size(); ++col) {
+                sf::Vector2f pos(static_cast<float>(col) * CELL_SIZE, static_cast<float>(row) * CELL_SIZE);
+                switch (line[col]) {
+                    case '#': // Solid block
+                        cells[col] = TileType::SOLID;
+                        break;
+                    case 'P': // Player spawn
+                        level.spawn_position = pos;
+                        break;
+                    case 'C': // Checkpoint
+                        level.checkpoints.push_back(pos);
+                        cells[col] = TileType::CHECKPOINT;
+                        break;
+                    case 'F': // Flag (end)
+                        level.flag_position = pos;
+                        cells[col] = TileType::FLAG;
+                        break;
+                    case 'E':
+                        level.spawns.push_back({SpawnKind::Enemy, pos});
+                        break;
+                    case 'V':
+                        level.spawns.push_back({SpawnKind::FlyingEnemy, pos});
+                        break;
+                    case 'O':
+                        level.spawns.push_back({SpawnKind::Coin, pos});
+                        level.coin_count++;
+                        break;
+                    default: // Empty
+                        break;
+                }
+            }
+        }
+
+        return level;
+    }
+
+} // namespace world
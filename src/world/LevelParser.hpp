@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Tile.hpp"
+#include <SFML/System.hpp>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace world {
+
+    // Entity spawn read from the level text. World only creates the entity while its
+    // chunk is resident (see TileMap::update_residency).
+    enum class SpawnKind : std::uint8_t { Enemy, FlyingEnemy, Coin };
+    struct SpawnPoint {
+        SpawnKind kind;
+        sf::Vector2f position;
+    };
+
+    // Non-owning view of a level, what TileMap and World load from. It points either into a
+    // parsed LevelDescription or straight into a mapped compiled level (see CompiledLevel).
+    struct LevelView {
+        std::span<const TileType> tiles; // Row-major, width * height
+        int width = 0;
+        int height = 0;
+        sf::Vector2f spawn_position;
+        sf::Vector2f flag_position;
+        std::span<const sf::Vector2f> checkpoints;
+        std::span<const SpawnPoint> spawns; // Row-major level order
+        int coin_count = 0;
+    };
+
+    // Everything a level text describes, gathered in one pass. TileMap takes the grid,
+    // spawn, flag and checkpoints; World takes the entity spawns.
+    struct LevelDescription {
+        explicit LevelDescription(std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+            : tiles(memory), checkpoints(memory), spawns(memory) {}
+
+        // Row-major, width * height. Lines shorter than the widest one are padded with EMPTY.
+        std::pmr::vector<TileType> tiles;
+        int width = 0;
+        int height = 0;
+        sf::Vector2f spawn_position{100.0f, 500.0f}; // Kept when the level has no 'P'
+        sf::Vector2f flag_position;
+        std::pmr::vector<sf::Vector2f> checkpoints;
+        std::pmr::vector<SpawnPoint> spawns; // Row-major level order
+        int coin_count = 0;
+
+        [[nodiscard]] LevelView view() const {
+            return LevelView{tiles, width, height, spawn_position, flag_position, checkpoints, spawns, coin_count};
+        }
+    };
+
+    // Parses level text ('#' solid, 'P' player, 'C' checkpoint, 'F' flag, 'E' walker,
+    // 'V' flyer, 'O' coin) without copying it. Lines are views into `level_data`.
+    [[nodiscard]] LevelDescription parse_level(std::string_view level_data,
+                                               std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+} // namespace world
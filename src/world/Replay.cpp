@@ -0,0 +1,177 @@
+#include "Replay.hpp"
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace world {
+
+    namespace {
+        // Fixed little-endian encoding so replays move between machines
+        void write_u32(std::string& out, std::uint32_t value) {
+            for (int i = 0; i < 4; ++i) out += static_cast<char>((value >> (8 * i)) & 0xFF);
+        }
+
+        void write_u64(std::string& out, std::uint64_t value) {
+            for (int i = 0; i < 8; ++i) out += static_cast<char>((value >> (8 * i)) & 0xFF);
+        }
+
+        // LEB128: run lengths are usually small, so most take a single byte
+        void write_varint(std::string& out, std::uint64_t value) {
+            while (value >= 0x80) {
+                out += static_cast<char>((value & 0x7F) | 0x80);
+                value >>= 7;
+            }
+            out += static_cast<char>(value);
+        }
+
+        class Reader {
+        public:
+            explicit Reader(const std::string& data) : m_data(data) {}
+
+            bool read_bytes(void* dest, size_t count) {
+                if (m_offset + count > m_data.size()) return false;
+                std::memcpy(dest, m_data.data() + m_offset, count);
+                m_offset += count;
+                return true;
+            }
+
+            bool read_u64(std::uint64_t& value, int bytes = 8) {
+                value = 0;
+                for (int i = 0; i < bytes; ++i) {
+                    if (m_offset >= m_data.size()) return false;
+                    value |= static_cast<std::uint64_t>(static_cast<unsigned char>(m_data[m_offset++])) << (8 * i);
+                }
+                return true;
+            }
+
+            bool read_varint(std::uint64_t& value) {
+                value = 0;
+                for (int shift = 0; shift < 64; shift += 7) {
+                    if (m_offset >= m_data.size()) return false;
+                    auto byte = static_cast<unsigned char>(m_data[m_offset++]);
+                    value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                    if ((byte & 0x80) == 0) return true;
+                }
+                return false;
+            }
+
+        private:
+            const std::string& m_data;
+            size_t m_offset = 0;
+        };
+    }
+
+    void Replay::begin(int level_id, const std::string& custom_level_data, float step) {
+        m_level_id = level_id;
+        m_level_data = level_id < 0 ? custom_level_data : std::string();
+        m_step = step;
+        m_tick_count = 0;
+        m_final_state_hash = 0;
+        m_finished = false;
+        m_runs.clear();
+    }
+
+    void Replay::record(const entities::PlayerInput& input) {
+        std::uint8_t bits = input.to_bits();
+        if (!m_runs.empty() && m_runs.back().bits == bits && m_runs.back().ticks < UINT32_MAX) {
+            m_runs.back().ticks++;
+        } else {
+            m_runs.push_back({bits, 1});
+        }
+        m_tick_count++;
+    }
+
+    void Replay::finish(std::uint64_t final_state_hash) {
+        m_final_state_hash = final_state_hash;
+        m_finished = true;
+    }
+
+    bool Replay::save(const std::filesystem::path& path) const {
+        std::string out(MAGIC, sizeof(MAGIC));
+        out += static_cast<char>(VERSION & 0xFF);
+        out += static_cast<char>(VERSION >> 8);
+        write_u32(out, static_cast<std::uint32_t>(m_level_id));
+        write_u32(out, std::bit_cast<std::uint32_t>(m_step));
+        write_u64(out, m_tick_count);
+        write_u64(out, m_final_state_hash);
+        out += static_cast<char>(m_finished ? 1 : 0);
+        write_varint(out, m_level_data.size());
+        out += m_level_data;
+        write_varint(out, m_runs.size());
+        for (const auto& run : m_runs) {
+            out += static_cast<char>(run.bits);
+            write_varint(out, run.ticks);
+        }
+
+        if (path.has_parent_path()) {
+            std::error_code ec;
+            std::filesystem::create_directories(path.parent_path(), ec);
+        }
+        std::ofstream file(path, std::ios::binary);
+        if (!file || !file.write(out.data(), static_cast<std::streamsize>(out.size()))) {
+            std::cerr << "[ERROR] Failed to write replay: " << path << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    std::optional<Replay> Replay::load(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            std::cerr << "[ERROR] Cannot open replay: " << path << std::endl;
+            return std::nullopt;
+        }
+        std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        Reader reader(data);
+
+        char magic[sizeof(MAGIC)];
+        std::uint64_t version = 0, level_id = 0, step_bits = 0, finished = 0, level_size = 0, run_count = 0;
+        Replay replay;
+        if (!reader.read_bytes(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+            !reader.read_u64(version, 2) || version != VERSION) {
+            std::cerr << "[ERROR] Not a replay file (or unsupported version): " << path << std::endl;
+            return std::nullopt;
+        }
+        bool ok = reader.read_u64(level_id, 4) && reader.read_u64(step_bits, 4) &&
+                  reader.read_u64(replay.m_tick_count) && reader.read_u64(replay.m_final_state_hash) &&
+                  reader.read_u64(finished, 1) && reader.read_varint(level_size) && level_size <= data.size();
+        if (ok) {
+            replay.m_level_data.resize(level_size);
+            ok = reader.read_bytes(replay.m_level_data.data(), level_size) && reader.read_varint(run_count);
+        }
+
+        std::uint64_t ticks = 0;
+        for (std::uint64_t i = 0; ok && i < run_count; ++i) {
+            std::uint64_t bits = 0, length = 0;
+            ok = reader.read_u64(bits, 1) && reader.read_varint(length) && length > 0 && length <= UINT32_MAX;
+            if (ok) {
+                replay.m_runs.push_back({static_cast<std::uint8_t>(bits), static_cast<std::uint32_t>(length)});
+                ticks += length;
+            }
+        }
+        if (!ok || ticks != replay.m_tick_count) {
+            std::cerr << "[ERROR] Corrupted replay: " << path << std::endl;
+            return std::nullopt;
+        }
+
+        replay.m_level_id = static_cast<int>(static_cast<std::uint32_t>(level_id));
+        replay.m_step = std::bit_cast<float>(static_cast<std::uint32_t>(step_bits));
+        replay.m_finished = finished != 0;
+        return replay;
+    }
+
+    bool Replay::Cursor::next(entities::PlayerInput& input) {
+        while (m_run < m_replay.m_runs.size() && m_used >= m_replay.m_runs[m_run].ticks) {
+            m_run++;
+            m_used = 0;
+        }
+        if (m_run >= m_replay.m_runs.size()) return false;
+
+        input = entities::PlayerInput::from_bits(m_replay.m_runs[m_run].bits);
+        m_used++;
+        return true;
+    }
+
+} // namespace world
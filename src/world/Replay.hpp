@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../entities/PlayerInput.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace world {
+
+    // Per-tick player input of one World session, run-length encoded. With the fixed tick
+    // the simulation is deterministic, so feeding the same inputs to a World built from the
+    // same level reproduces the run exactly; the final state hash recorded at the end lets
+    // playback verify that (see World::compute_state_hash).
+    class Replay {
+    public:
+        // Starts a new recording. Built-in levels are referenced by id, custom levels
+        // (level_id < 0) carry their level text so the file is self-contained.
+        // step is the fixed tick length in seconds, stored bit-exact since it feeds the physics
+        void begin(int level_id, const std::string& custom_level_data, float step);
+        void record(const entities::PlayerInput& input);
+        void finish(std::uint64_t final_state_hash);
+        void set_step(float step) { m_step = step; }
+        // Level text of a custom level run, for recordings begun without it (a level played
+        // from its compiled file only needs the text once the replay is saved)
+        void set_level_data(const std::string& custom_level_data) { m_level_data = custom_level_data; }
+
+        bool save(const std::filesystem::path& path) const;
+        [[nodiscard]] static std::optional<Replay> load(const std::filesystem::path& path);
+
+        [[nodiscard]] int get_level_id() const { return m_level_id; }
+        [[nodiscard]] const std::string& get_level_data() const { return m_level_data; }
+        [[nodiscard]] float get_step() const { return m_step; }
+        [[nodiscard]] std::uint64_t get_tick_count() const { return m_tick_count; }
+        [[nodiscard]] std::uint64_t get_final_state_hash() const { return m_final_state_hash; }
+        [[nodiscard]] bool is_finished() const { return m_finished; }
+
+        // Sequential playback, one input per tick
+        class Cursor {
+        public:
+            explicit Cursor(const Replay& replay) : m_replay(replay) {}
+            // Next tick's input, or false once every recorded tick has been played
+            bool next(entities::PlayerInput& input);
+
+        private:
+            const Replay& m_replay;
+            size_t m_run = 0;
+            std::uint32_t m_used = 0; // Ticks already played from the current run
+        };
+
+        static constexpr const char* DEFAULT_PATH = "replays/last_run.replay";
+
+    private:
+        struct InputRun {
+            std::uint8_t bits;
+            std::uint32_t ticks;
+        };
+
+        int m_level_id = 0;
+        std::string m_level_data;
+        float m_step = 0.0f;
+        std::uint64_t m_tick_count = 0;
+        std::uint64_t m_final_state_hash = 0;
+        bool m_finished = false;
+        std::vector<InputRun> m_runs;
+
+        static constexpr char MAGIC[4] = {'T', 'Q', 'R', 'P'};
+        static constexpr std::uint16_t VERSION = 2; // 2: state hash over the enemy store and spawn flags
+    };
+
+} // namespace world
@@ -1,28 +1,20 @@
 #pragma once
 
-#include <SFML/Graphics.hpp>
-#include <optional>
+#include <cstdint>
 
 namespace world {
 
-    enum class TileType {
+    // Stored as one byte per cell in TileMap's grid. Position comes from the cell index
+    // and appearance from TileMap's per-type table, so a tile is nothing but its type.
+    enum class TileType : std::uint8_t {
         EMPTY,
         SOLID,
         CHECKPOINT,
-        FLAG
+        CHECKPOINT_ACTIVE,
+        FLAG,
+        COUNT
     };
 
-    struct Tile {
-        TileType type;
-        sf::Vector2f position;
-        std::optional<sf::Sprite> sprite;
-        
-        Tile() : type(TileType::EMPTY), position(0.0f, 0.0f), sprite(std::nullopt) {}
-        Tile(TileType t, const sf::Vector2f& pos) : type(t), position(pos), sprite(std::nullopt) {}
-        
-        sf::FloatRect get_bounds() const {
-            return sf::FloatRect(position, sf::Vector2f(32.0f, 32.0f));
-        }
-    };
+    constexpr int TILE_TYPE_COUNT = static_cast<int>(TileType::COUNT);
 
 } // namespace world
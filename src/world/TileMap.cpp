@@ -1,226 +1,308 @@
 #include "TileMap.hpp"
-#include <sstream>
+#include "../core/SpriteBatch.hpp"
+#include "../core/AssetLoader.hpp"
 #include <iostream>
 
 namespace world {
 
-    TileMap::TileMap() : m_spawn_position(100.0f, 500.0f), m_flag_position(0.0f, 0.0f) {}
+    namespace {
+        const char* const UNDERGROUND_TEXTURE = "assets/Pack_to_pick/Game/Sprites/Tiles/Default/terrain_grass_block_bottom.png";
 
-    void TileMap::load_from_string(const std::string& level_data, int level_id) {
+        std::string background_name(int level_id) {
+            return "background_" + std::to_string(level_id);
+        }
+
+        std::filesystem::path background_path(int level_id) {
+            const std::string dir = "assets/Pack_to_pick/Game/Sprites/Backgrounds/Default/";
+            switch (level_id) {
+                case 1: return dir + "background_color_hills.png";
+                case 2: return dir + "background_color_trees.png";
+                case 3: return dir + "background_color_mushrooms.png";
+                case 4: return dir + "background_color_desert.png";
+                case 5: return dir + "background_fade_trees.png";
+                default: return dir + "background_color_hills.png";
+            }
+        }
+
+        // Appends a TILE_SIZE quad showing `region`, as two triangles
+        void append_tile_quad(sf::VertexArray& vertices, const sf::Vector2f& pos, const core::TextureRegion& region) {
+            core::SpriteBatch::append_quad(vertices, sf::FloatRect(pos, {TileMap::TILE_SIZE, TileMap::TILE_SIZE}), region.rect);
+        }
+    }
+
+    void TileMap::queue_assets(core::AssetLoader& loader, int level_id) {
+        // Tile and flag sprites are in the atlas; only the standalone textures are queued
+        auto& rm = core::ResourceManager::instance();
+        loader.queue_texture(rm, "grass_bottom", UNDERGROUND_TEXTURE);
+        loader.queue_texture(rm, background_name(level_id), background_path(level_id));
+    }
+
+    TileMap::TileMap(std::pmr::memory_resource* memory)
+        : m_tiles(memory), m_solid_rects(memory), m_spawn_position(100.0f, 500.0f), m_flag_position(0.0f, 0.0f),
+          m_chunks(memory) {}
+
+    void TileMap::load_from_string(std::string_view level_data, int level_id) {
+        load(parse_level(level_data).view(), level_id);
+    }
+
+    void TileMap::load(const LevelView& level, int level_id) {
         m_tiles.clear();
+        m_width = 0;
+        m_height = 0;
+        m_solid_rects.clear();
         m_checkpoint_positions.clear();
-        m_underground_sprites.clear();
-        m_checkpoint_sprites.clear();
-        m_activated_checkpoints.clear();
+        m_chunks.clear();
+        m_resident = ChunkRange{};
         
-        std::istringstream stream(level_data);
-        std::string line;
-        int row = 0;
+        auto& rm = core::ResourceManager::instance();
         
-        // Load grass tile texture
-        auto& tile_tex = core::ResourceManager::instance().load_texture("grass_tile", 
-            "assets/gameplay/tiles/terrain_grass_block.png");
-        
-        // Load underground texture (same for all layers)
-        auto& grass_bottom_tex = core::ResourceManager::instance().load_texture("grass_bottom",
-            "assets/Pack_to_pick/Game/Sprites/Tiles/Default/terrain_grass_block_bottom.png");
-        
-        // Load checkpoint textures
-        auto& checkpoint_tex = core::ResourceManager::instance().load_texture("checkpoint",
+        // Tile sprites come from the atlas when it has been built
+        m_tile_regions = {};
+        m_tile_regions[static_cast<int>(TileType::SOLID)] = rm.load_region("grass_tile", "assets/gameplay/tiles/terrain_grass_block.png");
+        m_tile_regions[static_cast<int>(TileType::CHECKPOINT)] = rm.load_region("checkpoint",
             "assets/Pack_to_pick/Game/Sprites/Tiles/Default/switch_red.png");
-        auto& checkpoint_active_tex = core::ResourceManager::instance().load_texture("checkpoint_active",
+        m_tile_regions[static_cast<int>(TileType::CHECKPOINT_ACTIVE)] = rm.load_region("checkpoint_active",
             "assets/Pack_to_pick/Game/Sprites/Tiles/Default/switch_red_pressed.png");
         
+        // Load underground texture (same for all layers), tiled across one quad. Repeating
+        // needs a standalone texture, so this one stays out of the atlas.
+        auto& grass_bottom_tex = rm.load_texture("grass_bottom", UNDERGROUND_TEXTURE);
+        grass_bottom_tex.setRepeated(true);
+        m_underground_texture = &grass_bottom_tex;
+        
         // Load background based on level
-        std::string bg_path;
-        switch (level_id) {
-            case 1: bg_path = "assets/Pack_to_pick/Game/Sprites/Backgrounds/Default/background_color_hills.png"; break;
-            case 2: bg_path = "assets/Pack_to_pick/Game/Sprites/Backgrounds/Default/background_color_trees.png"; break;
-            case 3: bg_path = "assets/Pack_to_pick/Game/Sprites/Backgrounds/Default/background_color_mushrooms.png"; break;
-            case 4: bg_path = "assets/Pack_to_pick/Game/Sprites/Backgrounds/Default/background_color_desert.png"; break;
-            case 5: bg_path = "assets/Pack_to_pick/Game/Sprites/Backgrounds/Default/background_fade_trees.png"; break;
-            default: bg_path = "assets/Pack_to_pick/Game/Sprites/Backgrounds/Default/background_color_hills.png"; break;
-        }
-        auto& bg_tex = core::ResourceManager::instance().load_texture("background_" + std::to_string(level_id), bg_path);
+        auto& bg_tex = rm.load_texture(background_name(level_id), background_path(level_id));
         m_background_sprite = sf::Sprite(bg_tex);
         // Scale background to cover full screen (800x600)
         auto bg_size = bg_tex.getSize();
-        float bg_scale_x = 800.0f / static_cast<float>(bg_size.x);
-        float bg_scale_y = 600.0f / static_cast<float>(bg_size.y);
-        m_background_sprite->setScale({bg_scale_x, bg_scale_y});
-        
-        // Count total columns for level width
-        int max_cols = 0;
-        std::vector<std::string> lines;
-        while (std::getline(stream, line)) {
-            lines.push_back(line);
-            if (static_cast<int>(line.length()) > max_cols) {
-                max_cols = static_cast<int>(line.length());
-            }
+        if (bg_size.x > 0 && bg_size.y > 0) { // Headless textures are empty
+            float bg_scale_x = 800.0f / static_cast<float>(bg_size.x);
+            float bg_scale_y = 600.0f / static_cast<float>(bg_size.y);
+            m_background_sprite->setScale({bg_scale_x, bg_scale_y});
         }
         
-        // Process tiles
-        for (const auto& l : lines) {
-            std::vector<Tile> tile_row;
-            
-            for (size_t col = 0; col < l.length(); ++col) {
-                char c = l[col];
-                sf::Vector2f pos(col * TILE_SIZE, row * TILE_SIZE);
-                Tile tile;
-                
-                switch (c) {
-                    case '#': // Solid block
-                        tile = Tile(TileType::SOLID, pos);
-                        tile.sprite = sf::Sprite(tile_tex);
-                        tile.sprite->setPosition(pos);
-                        {
-                            // Scale sprite to fit TILE_SIZE (32x32)
-                            auto texSize = tile_tex.getSize();
-                            float scaleX = TILE_SIZE / static_cast<float>(texSize.x);
-                            float scaleY = TILE_SIZE / static_cast<float>(texSize.y);
-                            tile.sprite->setScale({scaleX, scaleY});
-                        }
-                        break;
-                    case 'P': // Player spawn
-                        m_spawn_position = pos;
-                        tile = Tile(TileType::EMPTY, pos);
-                        break;
-                    case 'C': // Checkpoint
-                        m_checkpoint_positions.push_back(pos);
-                        tile = Tile(TileType::CHECKPOINT, pos);
-                        {
-                            // Create checkpoint sprite (initially not activated)
-                            sf::Sprite cp_sprite(checkpoint_tex);
-                            cp_sprite.setPosition(pos);
-                            auto cp_size = checkpoint_tex.getSize();
-                            float cp_scaleX = TILE_SIZE / static_cast<float>(cp_size.x);
-                            float cp_scaleY = TILE_SIZE / static_cast<float>(cp_size.y);
-                            cp_sprite.setScale({cp_scaleX, cp_scaleY});
-                            m_checkpoint_sprites.push_back(cp_sprite);
-                        }
-                        break;
-                    case 'F': // Flag (end)
-                        m_flag_position = pos;
-                        tile = Tile(TileType::FLAG, pos);
-                        break;
-                    default: // Empty
-                        tile = Tile(TileType::EMPTY, pos);
-                        break;
+        m_width = level.width;
+        m_height = level.height;
+        m_tiles.assign(level.tiles.begin(), level.tiles.end());
+        m_spawn_position = level.spawn_position;
+        m_flag_position = level.flag_position;
+        m_checkpoint_positions.assign(level.checkpoints.begin(), level.checkpoints.end());
+        
+        // Collision boxes, row-major like the grid
+        for (int row = 0; row < m_height; ++row) {
+            const TileType* cells = row_data(row);
+            for (int col = 0; col < m_width; ++col) {
+                if (cells[col] == TileType::SOLID) {
+                    m_solid_rects.push_back(get_tile_bounds(col, row));
                 }
-                
-                tile_row.push_back(tile);
             }
-            
-            m_tiles.push_back(tile_row);
-            row++;
         }
         
-        // Create underground sprites below the level to fill until bottom of screen (600px)
-        int level_height = static_cast<int>(m_tiles.size());
-        m_level_width = max_cols * TILE_SIZE;
+        // Underground rows below the level fill until the bottom of the screen (600px)
+        m_level_width = m_width * TILE_SIZE;
         
         // Calculate how many underground rows needed to reach 600px (screen height)
-        float level_pixel_height = level_height * TILE_SIZE;
-        int underground_rows = static_cast<int>((600.0f - level_pixel_height) / TILE_SIZE) + 2; // +2 for safety margin
-        if (underground_rows < 1) underground_rows = 1;
-        
-        for (int depth = 0; depth < underground_rows; ++depth) {
-            for (int col = 0; col < max_cols; ++col) {
-                sf::Vector2f pos(col * TILE_SIZE, (level_height + depth) * TILE_SIZE);
-                
-                // Use same texture for all underground layers
-                sf::Sprite underground_sprite(grass_bottom_tex);
-                underground_sprite.setPosition(pos);
-                // Scale to fit TILE_SIZE
-                auto texSize = grass_bottom_tex.getSize();
-                float scaleX = TILE_SIZE / static_cast<float>(texSize.x);
-                float scaleY = TILE_SIZE / static_cast<float>(texSize.y);
-                underground_sprite.setScale({scaleX, scaleY});
-                
-                m_underground_sprites.push_back(underground_sprite);
-            }
-        }
+        float level_pixel_height = m_height * TILE_SIZE;
+        m_underground_rows = static_cast<int>((600.0f - level_pixel_height) / TILE_SIZE) + 2; // +2 for safety margin
+        if (m_underground_rows < 1) m_underground_rows = 1;
+        
+        // Geometry is baked lazily the first time a chunk becomes visible
+        m_chunks.resize(static_cast<size_t>((m_width + CHUNK_COLUMNS - 1) / CHUNK_COLUMNS));
         
         // Load flag sprite with correct texture
-        auto& flag_tex = core::ResourceManager::instance().load_texture("flag_yellow", 
+        core::TextureRegion flag_region = rm.load_region("flag_yellow", 
             "assets/Pack_to_pick/Game/Sprites/Tiles/Default/flag_yellow_a.png");
-        m_flag_sprite = sf::Sprite(flag_tex);
+        m_flag_sprite = sf::Sprite(*flag_region.texture, flag_region.rect);
         m_flag_sprite->setPosition(m_flag_position);
         // Scale flag to fit tile
-        auto flag_size = flag_tex.getSize();
-        float flag_scaleX = TILE_SIZE / static_cast<float>(flag_size.x);
-        float flag_scaleY = TILE_SIZE / static_cast<float>(flag_size.y);
+        float flag_scaleX = TILE_SIZE / static_cast<float>(flag_region.rect.size.x);
+        float flag_scaleY = TILE_SIZE / static_cast<float>(flag_region.rect.size.y);
         m_flag_sprite->setScale({flag_scaleX, flag_scaleY});
         
-        std::cout << "Loaded level " << level_id << " with " << m_tiles.size() << " rows and background" << std::endl;
+        std::cout << "Loaded level " << level_id << " with " << m_height << " rows and background" << std::endl;
     }
 
     void TileMap::render(core::GameWindow& window, const sf::View& camera) {
+        sf::Vector2f camera_center = camera.getCenter();
+        sf::Vector2f camera_size = camera.getSize();
+        float view_left = camera_center.x - camera_size.x / 2.0f;
+        float view_right = camera_center.x + camera_size.x / 2.0f;
+        
         // Render background first, positioned based on camera
         if (m_background_sprite) {
-            // Get camera center and calculate background position
-            sf::Vector2f camera_center = camera.getCenter();
-            sf::Vector2f camera_size = camera.getSize();
-            
             // Position background to follow camera (left edge of view)
-            float bg_x = camera_center.x - camera_size.x / 2.0f;
-            m_background_sprite->setPosition({bg_x, 0.0f});
-            
+            m_background_sprite->setPosition({view_left, 0.0f});
             window.draw(*m_background_sprite);
         }
         
-        // Render underground sprites
-        for (const auto& sprite : m_underground_sprites) {
-            window.draw(sprite);
+        // Underground fill, clipped to the visible part of the level
+        float fill_left = std::max(0.0f, view_left);
+        float fill_right = std::min(m_level_width, view_right);
+        if (fill_right > fill_left && m_underground_texture) {
+            update_underground_quad(fill_left, fill_right);
+            window.draw(m_underground_quad, sf::RenderStates(m_underground_texture));
         }
         
-        // Render tiles
-        for (const auto& row : m_tiles) {
-            for (const auto& tile : row) {
-                if (tile.type == TileType::SOLID && tile.sprite.has_value()) {
-                    window.draw(tile.sprite.value());
-                }
+        // Only chunks overlapping the camera are drawn (and baked, if needed)
+        prepare_render(camera);
+        ChunkRange visible = visible_chunks(camera);
+        for (int i = visible.first; i <= visible.last; ++i) {
+            for (const auto& batch : m_chunks[i].batches) {
+                window.draw(batch.vertices, sf::RenderStates(batch.texture));
             }
         }
         
-        // Render checkpoints
-        for (const auto& cp_sprite : m_checkpoint_sprites) {
-            window.draw(cp_sprite);
-        }
-        
         // Render flag
-        if (m_flag_sprite) {
+        if (m_flag_sprite && m_flag_position.x + TILE_SIZE >= view_left && m_flag_position.x <= view_right) {
             window.draw(*m_flag_sprite);
         }
     }
     
-    void TileMap::activate_checkpoint(const sf::Vector2f& position) {
-        // Find the checkpoint index at this position
-        for (size_t i = 0; i < m_checkpoint_positions.size(); ++i) {
-            if (m_checkpoint_positions[i] == position && m_activated_checkpoints.find(i) == m_activated_checkpoints.end()) {
-                // Mark as activated
-                m_activated_checkpoints.insert(i);
-                
-                // Change texture to pressed
-                auto& checkpoint_active_tex = core::ResourceManager::instance().get_texture("checkpoint_active");
-                if (i < m_checkpoint_sprites.size()) {
-                    m_checkpoint_sprites[i].setTexture(checkpoint_active_tex);
-                }
-                break;
+    TileMap::ChunkRange TileMap::visible_chunks(const sf::View& camera) const {
+        float view_left = camera.getCenter().x - camera.getSize().x / 2.0f;
+        float view_right = camera.getCenter().x + camera.getSize().x / 2.0f;
+        return ChunkRange{std::max(0, chunk_of(view_left)), std::min(get_chunk_count() - 1, chunk_of(view_right))};
+    }
+
+    void TileMap::prepare_render(const sf::View& camera) {
+        ChunkRange visible = visible_chunks(camera);
+        for (int i = visible.first; i <= visible.last; ++i) {
+            if (m_chunks[i].dirty) {
+                rebuild_chunk(i);
             }
         }
     }
 
-    std::vector<Tile> TileMap::get_solid_tiles() const {
-        std::vector<Tile> solid_tiles;
-        for (const auto& row : m_tiles) {
-            for (const auto& tile : row) {
-                if (tile.type == TileType::SOLID) {
-                    solid_tiles.push_back(tile);
+    void TileMap::invalidate_geometry() {
+        for (auto& chunk : m_chunks) {
+            chunk.dirty = true;
+        }
+    }
+
+    void TileMap::rebuild_chunk(int chunk_index) {
+        RenderChunk& chunk = m_chunks[chunk_index];
+        chunk.batches.clear();
+        
+        // Tiles sharing a texture page share a batch; the first tile using a page opens it,
+        // so solids still come before checkpoints when they end up on different pages
+        auto batch_for = [&chunk](const sf::Texture* texture) -> sf::VertexArray& {
+            for (auto& batch : chunk.batches) {
+                if (batch.texture == texture) return batch.vertices;
+            }
+            chunk.batches.push_back(ChunkBatch{texture, sf::VertexArray(sf::PrimitiveType::Triangles)});
+            return chunk.batches.back().vertices;
+        };
+        
+        int col_begin = chunk_index * CHUNK_COLUMNS;
+        int col_end = std::min(col_begin + CHUNK_COLUMNS, m_width);
+        
+        for (int row = 0; row < m_height; ++row) {
+            const TileType* cells = row_data(row);
+            for (int col = col_begin; col < col_end; ++col) {
+                const core::TextureRegion& region = m_tile_regions[static_cast<int>(cells[col])];
+                if (!region.texture) continue;
+                append_tile_quad(batch_for(region.texture), sf::Vector2f(col * TILE_SIZE, row * TILE_SIZE), region);
+            }
+        }
+        
+        chunk.dirty = false;
+    }
+    
+    void TileMap::update_underground_quad(float left, float right) {
+        // One texture repeat per tile: texture coordinates run in texels, past the texture size
+        const sf::Vector2f tex_size(m_underground_texture->getSize());
+        const float top = get_height() * TILE_SIZE;
+        const float bottom = top + m_underground_rows * TILE_SIZE;
+        const float u_left = left / TILE_SIZE * tex_size.x;
+        const float u_right = right / TILE_SIZE * tex_size.x;
+        const float v_bottom = m_underground_rows * tex_size.y;
+        
+        m_underground_quad[0] = sf::Vertex{{left, top}, sf::Color::White, {u_left, 0.0f}};
+        m_underground_quad[1] = sf::Vertex{{right, top}, sf::Color::White, {u_right, 0.0f}};
+        m_underground_quad[2] = sf::Vertex{{left, bottom}, sf::Color::White, {u_left, v_bottom}};
+        m_underground_quad[3] = m_underground_quad[2];
+        m_underground_quad[4] = m_underground_quad[1];
+        m_underground_quad[5] = sf::Vertex{{right, bottom}, sf::Color::White, {u_right, v_bottom}};
+    }
+    
+    TileMap::ChunkRange TileMap::update_residency(const sf::View& camera) {
+        if (!is_streaming()) {
+            // Small levels: everything stays resident, like before streaming existed
+            m_resident = ChunkRange{0, get_chunk_count() - 1};
+            return m_resident;
+        }
+        
+        float view_left = camera.getCenter().x - camera.getSize().x / 2.0f;
+        float view_right = camera.getCenter().x + camera.getSize().x / 2.0f;
+        int visible_first = chunk_of(view_left);
+        int visible_last = chunk_of(view_right);
+        
+        // Load a couple of chunks ahead, but only evict a bit further out so that a camera
+        // hovering on a chunk border does not load and evict the same chunk every frame
+        ChunkRange wanted{visible_first - STREAM_LOAD_MARGIN, visible_last + STREAM_LOAD_MARGIN};
+        ChunkRange next = wanted;
+        if (m_resident.first < wanted.first && m_resident.first >= visible_first - STREAM_EVICT_MARGIN) {
+            next.first = m_resident.first;
+        }
+        if (m_resident.last > wanted.last && m_resident.last <= visible_last + STREAM_EVICT_MARGIN) {
+            next.last = m_resident.last;
+        }
+        next.first = std::max(next.first, 0);
+        next.last = std::min(next.last, get_chunk_count() - 1);
+        
+        // Free the geometry of chunks leaving the window; it is rebaked if they come back
+        for (int i = m_resident.first; i <= m_resident.last; ++i) {
+            if (!next.contains(i)) {
+                std::vector<ChunkBatch>().swap(m_chunks[i].batches);
+                m_chunks[i].dirty = true;
+            }
+        }
+        
+        m_resident = next;
+        return m_resident;
+    }
+    
+    void TileMap::mark_dirty_at(const sf::Vector2f& position) {
+        int chunk_index = static_cast<int>(position.x / TILE_SIZE) / CHUNK_COLUMNS;
+        if (chunk_index >= 0 && chunk_index < static_cast<int>(m_chunks.size())) {
+            m_chunks[chunk_index].dirty = true;
+        }
+    }
+    
+    void TileMap::activate_checkpoint(const sf::Vector2f& position) {
+        int col = static_cast<int>(std::floor(position.x / TILE_SIZE));
+        int row = static_cast<int>(std::floor(position.y / TILE_SIZE));
+        if (get_tile(col, row) == TileType::CHECKPOINT) {
+            // The cell switches type; its chunk re-bakes with the pressed texture on next render
+            cell(col, row) = TileType::CHECKPOINT_ACTIVE;
+            mark_dirty_at(position);
+        }
+    }
+
+    std::optional<sf::FloatRect> TileMap::find_solid_overlap(const sf::FloatRect& area) const {
+        CellRange range = cell_range(area);
+        for (int row = range.row_begin; row <= range.row_end; ++row) {
+            const TileType* cells = row_data(row);
+            for (int col = range.col_begin; col <= range.col_end; ++col) {
+                if (cells[col] != TileType::SOLID) continue;
+                sf::FloatRect tile_bounds = get_tile_bounds(col, row);
+                if (area.findIntersection(tile_bounds)) {
+                    return tile_bounds;
                 }
             }
         }
-        return solid_tiles;
+        return std::nullopt;
+    }
+
+    bool TileMap::is_solid(int col, int row) const {
+        return get_tile(col, row) == TileType::SOLID;
+    }
+
+    TileType TileMap::get_tile(int col, int row) const {
+        if (row < 0 || row >= m_height || col < 0 || col >= m_width) {
+            return TileType::EMPTY;
+        }
+        return row_data(row)[col];
     }
 
 } // namespace world
@@ -1,31 +1,126 @@
 #pragma once
 
 #include "Tile.hpp"
+#include "LevelParser.hpp"
 #include "../core/ResourceManager.hpp"
 #include "../core/GameWindow.hpp"
 #include <vector>
 #include <string>
-#include <set>
+#include <string_view>
+#include <span>
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <cmath>
+#include <algorithm>
+
+namespace core {
+    class AssetLoader;
+}
 
 namespace world {
 
     class TileMap {
     public:
-        TileMap();
+        // Grid, collision and chunk tables are allocated from `memory` (see core::LevelArena)
+        explicit TileMap(std::pmr::memory_resource* memory = std::pmr::get_default_resource());
         ~TileMap() = default;
 
-        void load_from_string(const std::string& level_data, int level_id);
+        void load(const LevelView& level, int level_id);
+        // Parses and loads; callers that also need the spawns parse once and use load()
+        void load_from_string(std::string_view level_data, int level_id);
+        // Queues the textures load() would read from disk for `level_id`
+        static void queue_assets(core::AssetLoader& loader, int level_id);
         void render(core::GameWindow& window, const sf::View& camera);
+        // Bakes the geometry of the chunks visible from `camera` that are out of date.
+        // render() does this itself; exposed so render prep can be measured on its own.
+        void prepare_render(const sf::View& camera);
+        // Marks every chunk for rebaking, e.g. after the textures behind them changed
+        void invalidate_geometry();
         void activate_checkpoint(const sf::Vector2f& position);
         sf::Vector2f get_spawn_position() const { return m_spawn_position; }
         sf::Vector2f get_flag_position() const { return m_flag_position; }
-        std::vector<Tile> get_solid_tiles() const;
-        int get_width() const { return m_tiles.empty() ? 0 : static_cast<int>(m_tiles[0].size()); }
-        int get_height() const { return static_cast<int>(m_tiles.size()); }
+        // Bounds of every solid tile, built once in load(). The view stays valid
+        // until the next load, so per-frame callers never copy or allocate.
+        [[nodiscard]] std::span<const sf::FloatRect> get_solid_rects() const { return m_solid_rects; }
+        int get_width() const { return m_width; }
+        int get_height() const { return m_height; }
         std::vector<sf::Vector2f> get_checkpoint_positions() const { return m_checkpoint_positions; }
 
+        // Grid-indexed collision query: calls fn(tile_bounds) for every solid tile whose
+        // cell overlaps `area`, in row-major order. Only the cells under the rectangle are
+        // visited, so the cost depends on the size of `area` and not on the level size.
+        template <typename Fn>
+        void for_each_solid_in(const sf::FloatRect& area, Fn&& fn) const {
+            CellRange range = cell_range(area);
+            for (int row = range.row_begin; row <= range.row_end; ++row) {
+                const TileType* cells = row_data(row);
+                for (int col = range.col_begin; col <= range.col_end; ++col) {
+                    if (cells[col] == TileType::SOLID) {
+                        fn(get_tile_bounds(col, row));
+                    }
+                }
+            }
+        }
+
+        // First solid tile (row-major) actually intersecting `area`, if any. Same cell lookup
+        // as for_each_solid_in but stops at the first hit, for callers that only need one wall.
+        [[nodiscard]] std::optional<sf::FloatRect> find_solid_overlap(const sf::FloatRect& area) const;
+
+        [[nodiscard]] bool is_solid(int col, int row) const;
+        [[nodiscard]] TileType get_tile(int col, int row) const;
+        [[nodiscard]] static sf::FloatRect get_tile_bounds(int col, int row) {
+            return sf::FloatRect(sf::Vector2f(col * TILE_SIZE, row * TILE_SIZE), sf::Vector2f(TILE_SIZE, TILE_SIZE));
+        }
+
+        // Streaming: wide levels only keep the chunks around the camera resident. Evicted
+        // chunks drop their geometry; World uses the same window to spawn and despawn entities.
+        struct ChunkRange {
+            int first = 0;
+            int last = -1;
+            [[nodiscard]] bool contains(int chunk) const { return chunk >= first && chunk <= last; }
+        };
+        // Slides the resident window to follow the camera and returns it
+        ChunkRange update_residency(const sf::View& camera);
+        [[nodiscard]] ChunkRange get_resident_chunks() const { return m_resident; }
+        [[nodiscard]] int get_chunk_count() const { return static_cast<int>(m_chunks.size()); }
+        [[nodiscard]] bool is_streaming() const { return get_chunk_count() > STREAMING_MIN_CHUNKS; }
+        [[nodiscard]] static int chunk_of(float x) {
+            return static_cast<int>(std::floor(x / (CHUNK_COLUMNS * TILE_SIZE)));
+        }
+
+        static constexpr float TILE_SIZE = 32.0f;
+        static constexpr int CHUNK_COLUMNS = 16; // Columns per render chunk
+        static constexpr int STREAMING_MIN_CHUNKS = 16; // Narrower levels stay fully resident
+        static constexpr int STREAM_LOAD_MARGIN = 2;    // Chunks loaded on each side of the view
+        static constexpr int STREAM_EVICT_MARGIN = 3;   // Resident chunks are kept up to this far
+
     private:
-        std::vector<std::vector<Tile>> m_tiles;
+        // Inclusive cell bounds covered by a rectangle, clamped to the map
+        struct CellRange {
+            int col_begin;
+            int col_end;
+            int row_begin;
+            int row_end;
+        };
+        [[nodiscard]] CellRange cell_range(const sf::FloatRect& area) const {
+            return CellRange{
+                std::max(0, static_cast<int>(std::floor(area.position.x / TILE_SIZE))),
+                std::min(m_width - 1, static_cast<int>(std::floor((area.position.x + area.size.x) / TILE_SIZE))),
+                std::max(0, static_cast<int>(std::floor(area.position.y / TILE_SIZE))),
+                std::min(get_height() - 1, static_cast<int>(std::floor((area.position.y + area.size.y) / TILE_SIZE)))
+            };
+        }
+
+        // Row-major tile grid, m_width * m_height bytes. Lines shorter than the widest one
+        // are padded with EMPTY so every row has the same stride.
+        std::pmr::vector<TileType> m_tiles;
+        int m_width = 0;
+        int m_height = 0;
+        [[nodiscard]] const TileType* row_data(int row) const { return m_tiles.data() + static_cast<size_t>(row) * m_width; }
+        [[nodiscard]] TileType& cell(int col, int row) { return m_tiles[static_cast<size_t>(row) * m_width + col]; }
+        
+        std::pmr::vector<sf::FloatRect> m_solid_rects;
         sf::Vector2f m_spawn_position;
         sf::Vector2f m_flag_position;
         std::vector<sf::Vector2f> m_checkpoint_positions;
@@ -33,14 +128,37 @@ namespace world {
         
         // Background and underground layers
         std::optional<sf::Sprite> m_background_sprite;
-        std::vector<sf::Sprite> m_underground_sprites;
         float m_level_width = 0.0f;
+        int m_underground_rows = 0;
         
-        // Checkpoint sprites
-        std::vector<sf::Sprite> m_checkpoint_sprites;
-        std::set<int> m_activated_checkpoints;
+        // The underground is a single quad with a repeated texture, resized to the camera
+        // every frame, so its cost does not depend on the level width
+        sf::VertexArray m_underground_quad{sf::PrimitiveType::Triangles, 6};
+        
+        // Baked tile geometry, one chunk per CHUNK_COLUMNS columns spanning the full map height.
+        // Tiles are grouped by texture page, so with the atlas a visible chunk is a single draw
+        // instead of one per tile. Chunks are rebuilt lazily when marked dirty.
+        struct ChunkBatch {
+            const sf::Texture* texture = nullptr;
+            sf::VertexArray vertices{sf::PrimitiveType::Triangles};
+        };
+        struct RenderChunk {
+            std::vector<ChunkBatch> batches;
+            bool dirty = true;
+        };
+        std::pmr::vector<RenderChunk> m_chunks;
+        ChunkRange m_resident;
+        
+        // Appearance per tile type, shared by every cell of that type. Types without
+        // a texture (empty, and the flag which is drawn as a sprite) are skipped.
+        std::array<core::TextureRegion, TILE_TYPE_COUNT> m_tile_regions{};
+        const sf::Texture* m_underground_texture = nullptr;
+        
+        void rebuild_chunk(int chunk_index);
+        ChunkRange visible_chunks(const sf::View& camera) const;
+        void mark_dirty_at(const sf::Vector2f& position);
+        void update_underground_quad(float left, float right);
         
-        static constexpr float TILE_SIZE = 32.0f;
         static constexpr int UNDERGROUND_DEPTH = 5; // Number of underground rows
     };
 
@@ -1,95 +1,140 @@
 #include "World.hpp"
+#include "../core/AssetLoader.hpp"
 #include <iostream>
-#include <sstream>
+#include <algorithm>
 
 namespace world {
 
-    World::World(int level_id) : m_level_id(level_id), m_checkpoint_position(100.0f, 500.0f), 
-                                  m_level_complete(false), m_game_over(false), 
-                                  m_coins_collected(0), m_total_coins(0) {
+    World::World(int level_id, std::pmr::memory_resource* memory)
+        : m_level_id(level_id), m_enemies(memory), m_coins(memory),
+          m_spawns(memory), m_chunk_spawn_offsets(memory), m_spawn_state(memory), m_tilemap(memory),
+          m_checkpoint_position(100.0f, 500.0f), m_level_complete(false), m_game_over(false),
+          m_coins_collected(0), m_total_coins(0) {
         std::cout << "World initialized for Level " << m_level_id << std::endl;
-        
+        load_level(parse_level(get_level_data(level_id)).view(), level_id);
+    }
+
+    World::World(const std::string& custom_level_data, std::pmr::memory_resource* memory)
+        : m_level_id(-1), m_enemies(memory), m_coins(memory),
+          m_spawns(memory), m_chunk_spawn_offsets(memory), m_spawn_state(memory), m_tilemap(memory),
+          m_checkpoint_position(100.0f, 500.0f), m_level_complete(false), m_game_over(false),
+          m_coins_collected(0), m_total_coins(0) {
+        std::cout << "World initialized for Custom Level" << std::endl;
+        load_level(parse_level(custom_level_data).view(), -1);
+    }
+
+    World::World(const LevelView& level, int level_id, std::pmr::memory_resource* memory)
+        : m_level_id(level_id), m_enemies(memory), m_coins(memory),
+          m_spawns(memory), m_chunk_spawn_offsets(memory), m_spawn_state(memory), m_tilemap(memory),
+          m_checkpoint_position(100.0f, 500.0f), m_level_complete(false), m_game_over(false),
+          m_coins_collected(0), m_total_coins(0) {
+        std::cout << "World initialized from a loaded level (" << level.width << "x" << level.height << ")" << std::endl;
+        load_level(level, level_id);
+    }
+
+    void World::queue_assets(core::AssetLoader& loader, int level_id) {
+        TileMap::queue_assets(loader, level_id);
+        loader.queue_sounds(core::ResourceManager::instance(), core::sounds::LEVEL);
+    }
+
+    void World::load_level(const LevelView& level, int level_id) {
         // Initialize camera
         m_camera.setSize(sf::Vector2f(800.0f, 600.0f));
         m_camera.setCenter(sf::Vector2f(400.0f, 300.0f));
+        m_previous_camera_center = m_camera.getCenter();
         
-        // Load level data
-        std::string level_data = get_level_data(level_id);
-        m_tilemap.load_from_string(level_data, level_id);
+        // The same view feeds both the tile map and the spawn tables
+        m_tilemap.load(level, level_id);
         
         // Create player at spawn position
         m_player = std::make_unique<entities::Player>(m_tilemap.get_spawn_position());
         m_checkpoint_position = m_tilemap.get_spawn_position();
         
-        // Spawn enemies and coins from level data
-        std::istringstream stream(level_data);
-        std::string line;
-        int row = 0;
-        while (std::getline(stream, line)) {
-            for (size_t col = 0; col < line.length(); ++col) {
-                if (line[col] == 'E') {
-                    sf::Vector2f enemy_pos(col * 32.0f, row * 32.0f);
-                    m_enemies.push_back(std::make_unique<entities::Enemy>(enemy_pos));
-                } else if (line[col] == 'V') {
-                    sf::Vector2f fly_pos(col * 32.0f, row * 32.0f);
-                    m_flying_enemies.push_back(std::make_unique<entities::FlyingEnemy>(fly_pos));
-                } else if (line[col] == 'O') {
-                    sf::Vector2f coin_pos(col * 32.0f, row * 32.0f);
-                    m_coins.push_back(std::make_unique<entities::Coin>(coin_pos));
-                    m_total_coins++;
-                }
-            }
-            row++;
-        }
+        // Entities themselves are created per resident chunk
+        m_spawns.assign(level.spawns.begin(), level.spawns.end());
+        m_total_coins = level.coin_count;
         
-        std::cout << "Spawned " << m_enemies.size() << " enemies" << std::endl;
-        std::cout << "Spawned " << m_flying_enemies.size() << " flying enemies" << std::endl;
-        std::cout << "Spawned " << m_total_coins << " coins" << std::endl;
-    }
-
-    World::World(const std::string& custom_level_data) : m_level_id(-1), m_checkpoint_position(100.0f, 500.0f), 
-                                  m_level_complete(false), m_game_over(false), 
-                                  m_coins_collected(0), m_total_coins(0) {
-        std::cout << "World initialized for Custom Level" << std::endl;
-        
-        // Initialize camera
-        m_camera.setSize(sf::Vector2f(800.0f, 600.0f));
-        m_camera.setCenter(sf::Vector2f(400.0f, 300.0f));
+        // Bucket spawns by chunk (stable, so each chunk keeps the row-major level order)
+        std::ranges::stable_sort(m_spawns, {}, [](const SpawnPoint& spawn) { return TileMap::chunk_of(spawn.position.x); });
+        int chunk_count = m_tilemap.get_chunk_count();
+        m_chunk_spawn_offsets.assign(static_cast<size_t>(chunk_count) + 1, 0);
+        for (const auto& spawn : m_spawns) {
+            m_chunk_spawn_offsets[TileMap::chunk_of(spawn.position.x) + 1]++;
+        }
+        for (int c = 0; c < chunk_count; ++c) {
+            m_chunk_spawn_offsets[c + 1] += m_chunk_spawn_offsets[c];
+        }
+        m_spawn_state.assign(m_spawns.size(), 0);
         
-        // Load custom level data
-        m_tilemap.load_from_string(custom_level_data, -1);
+        // Sized for every spawn being live at once, so streaming never reallocates them
+        size_t coin_spawns = static_cast<size_t>(m_total_coins);
+        m_enemies.reserve(m_spawns.size() - coin_spawns);
+        m_coins.set_columns(m_tilemap.get_width());
+        m_coins.reserve(coin_spawns);
         
-        // Create player at spawn position
-        m_player = std::make_unique<entities::Player>(m_tilemap.get_spawn_position());
-        m_checkpoint_position = m_tilemap.get_spawn_position();
+        update_streaming();
         
-        // Spawn enemies and coins from level data
-        std::istringstream stream(custom_level_data);
-        std::string line;
-        int row = 0;
-        while (std::getline(stream, line)) {
-            for (size_t col = 0; col < line.length(); ++col) {
-                if (line[col] == 'E') {
-                    sf::Vector2f enemy_pos(col * 32.0f, row * 32.0f);
-                    m_enemies.push_back(std::make_unique<entities::Enemy>(enemy_pos));
-                } else if (line[col] == 'V') {
-                    sf::Vector2f fly_pos(col * 32.0f, row * 32.0f);
-                    m_flying_enemies.push_back(std::make_unique<entities::FlyingEnemy>(fly_pos));
-                } else if (line[col] == 'O') {
-                    sf::Vector2f coin_pos(col * 32.0f, row * 32.0f);
-                    m_coins.push_back(std::make_unique<entities::Coin>(coin_pos));
-                    m_total_coins++;
-                }
+        std::cout << "Level has " << m_spawns.size() << " spawns (" << m_total_coins << " coins), "
+                  << m_enemies.count(entities::EnemyStore::Kind::Walker) << " enemies, "
+                  << m_enemies.count(entities::EnemyStore::Kind::Flyer) << " flying enemies and "
+                  << m_coins.size() << " coins resident" << (m_tilemap.is_streaming() ? " (streaming)" : "") << std::endl;
+    }
+
+    void World::update_streaming() {
+        TileMap::ChunkRange previous = m_tilemap.get_resident_chunks();
+        TileMap::ChunkRange resident = m_tilemap.update_residency(m_camera);
+        if (resident.first == previous.first && resident.last == previous.last) return;
+        
+        despawn_outside(resident);
+        for (int chunk = resident.first; chunk <= resident.last; ++chunk) {
+            if (!previous.contains(chunk)) {
+                spawn_chunk(chunk);
             }
-            row++;
         }
-        
-        std::cout << "Spawned " << m_enemies.size() << " enemies" << std::endl;
-        std::cout << "Spawned " << m_flying_enemies.size() << " flying enemies" << std::endl;
-        std::cout << "Spawned " << m_total_coins << " coins" << std::endl;
+    }
+
+    void World::spawn_chunk(int chunk) {
+        for (std::uint32_t i = m_chunk_spawn_offsets[chunk]; i < m_chunk_spawn_offsets[chunk + 1]; ++i) {
+            if (m_spawn_state[i] & (SPAWN_ALIVE | SPAWN_COLLECTED)) continue;
+            
+            const SpawnPoint& spawn = m_spawns[i];
+            switch (spawn.kind) {
+                case SpawnKind::Enemy:
+                    m_enemies.spawn(entities::EnemyStore::Kind::Walker, spawn.position, i);
+                    break;
+                case SpawnKind::FlyingEnemy:
+                    m_enemies.spawn(entities::EnemyStore::Kind::Flyer, spawn.position, i);
+                    break;
+                case SpawnKind::Coin:
+                    m_coins.spawn(spawn.position, i);
+                    break;
+            }
+            m_spawn_state[i] |= SPAWN_ALIVE;
+        }
+    }
+
+    void World::despawn_outside(const TileMap::ChunkRange& resident) {
+        // Entities are dropped by where they are now (enemies walk), and their spawn
+        // becomes available again so they reappear at their start when it reloads
+        auto despawn = [&](auto& store) {
+            for (size_t i = 0; i < store.size();) {
+                if (resident.contains(TileMap::chunk_of(store.get_positions()[i].x))) {
+                    ++i;
+                    continue;
+                }
+                m_spawn_state[store.get_spawn_ids()[i]] &= static_cast<std::uint8_t>(~SPAWN_ALIVE);
+                store.remove(i);
+            }
+        };
+        despawn(m_enemies);
+        despawn(m_coins);
     }
 
     void World::update(float dt) {
+        // Snapshot the previous step for render interpolation. Done even when frozen so the
+        // last two states match and rendering settles instead of blending stale positions.
+        begin_step();
+        
         // Don't update if game is over or level complete
         if (m_game_over || m_level_complete) return;
         
@@ -99,18 +144,7 @@ namespace world {
             update_camera();
         }
         
-        // Update enemies
-        for (auto& enemy : m_enemies) {
-            enemy->update(dt);
-        }
-        
-        // Update flying enemies
-        for (auto& fly : m_flying_enemies) {
-            fly->update(dt);
-        }
-        
-        // Update coins (animation?)
-        // for (auto& coin : m_coins) coin->update(dt);
+        m_enemies.update(dt);
         
         handle_enemy_collisions();
         check_player_enemy_collision();
@@ -142,41 +176,78 @@ namespace world {
         
         // Update camera position (keep Y centered)
         m_camera.setCenter(sf::Vector2f(camera_x, 300.0f));
+        
+        // Load/evict level chunks (and their entities) as the camera scrolls
+        update_streaming();
     }
 
-    void World::render(core::GameWindow& window) {
-        m_tilemap.render(window, m_camera);
-        
-        // Render coins
-        for (const auto& coin : m_coins) {
-            coin->render(window);
-        }
-        
-        // Render enemies
-        for (const auto& enemy : m_enemies) {
-            enemy->render(window);
-        }
+    std::uint64_t World::compute_state_hash() const {
+        // FNV-1a over the raw bytes: any bit of drift in positions shows up
+        std::uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](const void* data, size_t size) {
+            const auto* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; ++i) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+        };
+        auto mix_vector = [&mix](const sf::Vector2f& v) {
+            mix(&v.x, sizeof(v.x));
+            mix(&v.y, sizeof(v.y));
+        };
         
-        // Render flying enemies
-        for (const auto& fly : m_flying_enemies) {
-            fly->render(window);
+        if (m_player) {
+            mix_vector(m_player->get_position());
+            mix_vector(m_player->get_velocity());
+            int lives = m_player->get_lives();
+            mix(&lives, sizeof(lives));
         }
-        
+        for (const auto& position : m_enemies.get_positions()) mix_vector(position);
+        mix(m_spawn_state.data(), m_spawn_state.size());
+        mix(&m_coins_collected, sizeof(m_coins_collected));
+        mix_vector(m_checkpoint_position);
+        std::uint8_t flags = static_cast<std::uint8_t>((m_level_complete ? 1 : 0) | (m_game_over ? 2 : 0));
+        mix(&flags, sizeof(flags));
+        return hash;
+    }
+
+    void World::begin_step() {
+        m_previous_camera_center = m_camera.getCenter();
+        if (m_player) m_player->begin_step();
+        m_enemies.begin_step();
+    }
+
+    sf::View World::get_render_camera(float alpha) const {
+        sf::View view = m_camera;
+        view.setCenter(m_previous_camera_center + (m_camera.getCenter() - m_previous_camera_center) * alpha);
+        return view;
+    }
+
+    void World::render(core::GameWindow& window, float alpha) {
+        sf::View camera = get_render_camera(alpha);
+        m_tilemap.render(window, camera);
+        
+        // One flush per layer: across atlas pages the batch only keeps first-use order,
+        // which would let enemies cover the player
+        m_coins.render(m_sprite_batch, camera);
+        m_sprite_batch.draw(window);
+        m_enemies.render(m_sprite_batch, alpha);
+        m_sprite_batch.draw(window);
         if (m_player) {
-            m_player->render(window);
+            m_player->render(m_sprite_batch, alpha);
+            m_sprite_batch.draw(window);
         }
     }
 
     void World::handle_collisions() {
         // Simple AABB collision with tiles
-        auto solid_tiles = m_tilemap.get_solid_tiles();
+        // Only the tiles under the player's bounds are tested (grid lookup), so this stays
+        // constant-time no matter how wide the level is.
         sf::FloatRect player_bounds = m_player->get_bounds();
         
         bool on_ground = false;
         
-        for (const auto& tile : solid_tiles) {
-            sf::FloatRect tile_bounds = tile.get_bounds();
-            
+        m_tilemap.for_each_solid_in(player_bounds, [&](const sf::FloatRect& tile_bounds) {
             if (player_bounds.findIntersection(tile_bounds)) {
                 // Calculate overlap
                 float overlap_left = (player_bounds.position.x + player_bounds.size.x) - tile_bounds.position.x;
@@ -212,21 +283,13 @@ namespace world {
                 m_player->set_position(pos);
                 m_player->set_velocity(vel);
             }
-        }
+        });
         
         m_player->set_on_ground(on_ground);
     }
 
     void World::handle_enemy_collisions() {
-        auto solid_tiles = m_tilemap.get_solid_tiles();
-        std::vector<sf::FloatRect> tile_bounds;
-        for (const auto& tile : solid_tiles) {
-            tile_bounds.push_back(tile.get_bounds());
-        }
-        
-        for (auto& enemy : m_enemies) {
-            enemy->check_wall_collision(tile_bounds);
-        }
+        m_enemies.resolve_walls(m_tilemap);
     }
 
     void World::check_player_enemy_collision() {
@@ -234,40 +297,16 @@ namespace world {
         
         sf::FloatRect player_bounds = m_player->get_bounds();
         
-        for (const auto& enemy : m_enemies) {
-            sf::FloatRect enemy_bounds = enemy->get_bounds();
-            
-            if (player_bounds.findIntersection(enemy_bounds)) {
-                // Player hit enemy - take damage and respawn
-                m_player->take_damage();
-                
-                if (m_player->get_lives() > 0) {
-                    m_player->reset_to_checkpoint(m_checkpoint_position);
-                    std::cout << "Player respawned at checkpoint!" << std::endl;
-                } else {
-                    m_game_over = true;
-                    std::cout << "Game Over!" << std::endl;
-                }
-                return; // Exit function to avoid double damage/death in same frame
-            }
-        }
-        
-        // Check flying enemies
-        for (const auto& fly : m_flying_enemies) {
-            sf::FloatRect enemy_bounds = fly->get_bounds();
+        if (m_enemies.find_overlap(player_bounds)) {
+            // Player hit enemy - take damage and respawn
+            m_player->take_damage();
             
-            if (player_bounds.findIntersection(enemy_bounds)) {
-                // Player hit enemy - take damage and respawn
-                m_player->take_damage();
-                
-                if (m_player->get_lives() > 0) {
-                    m_player->reset_to_checkpoint(m_checkpoint_position);
-                    std::cout << "Player respawned at checkpoint!" << std::endl;
-                } else {
-                    m_game_over = true;
-                    std::cout << "Game Over!" << std::endl;
-                }
-                return;
+            if (m_player->get_lives() > 0) {
+                m_player->reset_to_checkpoint(m_checkpoint_position);
+                std::cout << "Player respawned at checkpoint!" << std::endl;
+            } else {
+                m_game_over = true;
+                std::cout << "Game Over!" << std::endl;
             }
         }
     }
@@ -310,16 +349,14 @@ namespace world {
         
         sf::FloatRect player_bounds = m_player->get_bounds();
         
-        for (auto& coin : m_coins) {
-            if (!coin->is_collected()) {
-                sf::FloatRect coin_bounds = coin->get_bounds();
-                
-                if (player_bounds.findIntersection(coin_bounds)) {
-                    coin->collect();
-                    m_coins_collected++;
-                    std::cout << "Coin collected! (" << m_coins_collected << "/" << m_total_coins << ")" << std::endl;
-                }
-            }
+        // Only coins in the columns under the player are looked at
+        while (auto index = m_coins.find_overlap(player_bounds)) {
+            // The coin leaves the store for good; its spawn stays marked as collected
+            std::uint32_t spawn_id = m_coins.get_spawn_ids()[*index];
+            m_spawn_state[spawn_id] = static_cast<std::uint8_t>((m_spawn_state[spawn_id] & ~SPAWN_ALIVE) | SPAWN_COLLECTED);
+            m_coins.collect(*index);
+            m_coins_collected++;
+            std::cout << "Coin collected! (" << m_coins_collected << "/" << m_total_coins << ")" << std::endl;
         }
     }
 
@@ -4,30 +4,56 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <cstdint>
+#include <memory_resource>
 #include "../core/GameWindow.hpp"
 #include "../entities/Player.hpp"
-#include "../entities/Enemy.hpp"
-#include "../entities/FlyingEnemy.hpp"
-#include "../entities/Coin.hpp"
+#include "../entities/EnemyStore.hpp"
+#include "../entities/CoinStore.hpp"
 #include "TileMap.hpp"
+#include "LevelParser.hpp"
 
 namespace world {
 
     class World {
     public:
-        explicit World(int level_id);
-        explicit World(const std::string& custom_level_data);  // For custom levels
+        // Level storage (tiles, spawns, entities) comes from `memory`; pass a core::LevelArena
+        // resource to make rebuilding a level cheap
+        explicit World(int level_id, std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+        explicit World(const std::string& custom_level_data,  // For custom levels
+                       std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+        // Loads in place from an already parsed or compiled level (see CompiledLevel)
+        World(const LevelView& level, int level_id,
+              std::pmr::memory_resource* memory = std::pmr::get_default_resource());
         ~World() = default;
 
+        // Queues everything constructing a World for `level_id` (-1: custom) reads from
+        // disk, so it can be loaded in the background first
+        static void queue_assets(core::AssetLoader& loader, int level_id);
+
+        // One fixed simulation step
         void update(float dt);
-        void render(core::GameWindow& window);
+        // alpha blends between the previous and the current step (see core::FixedTimestep)
+        void render(core::GameWindow& window, float alpha = 1.0f);
+        // Input applied to the player on the following update() steps
+        void set_player_input(const entities::PlayerInput& input) { if (m_player) m_player->set_input(input); }
 
     private:
+        // Per-spawn state flags, kept across evictions
+        static constexpr std::uint8_t SPAWN_ALIVE = 1;     // An entity from this spawn exists
+        static constexpr std::uint8_t SPAWN_COLLECTED = 2; // Coin already picked up
+
         int m_level_id;
         std::unique_ptr<entities::Player> m_player;
-        std::vector<std::unique_ptr<entities::Enemy>> m_enemies;
-        std::vector<std::unique_ptr<entities::FlyingEnemy>> m_flying_enemies;
-        std::vector<std::unique_ptr<entities::Coin>> m_coins;
+        // Live entities; each remembers the index of the spawn it came from
+        entities::EnemyStore m_enemies;
+        entities::CoinStore m_coins;
+        
+        // Spawns sorted by chunk, so wide levels never hold every enemy and coin at once; chunk c owns [m_chunk_spawn_offsets[c], m_chunk_spawn_offsets[c + 1])
+        std::pmr::vector<SpawnPoint> m_spawns;
+        std::pmr::vector<std::uint32_t> m_chunk_spawn_offsets;
+        std::pmr::vector<std::uint8_t> m_spawn_state;
         TileMap m_tilemap;
         sf::Vector2f m_checkpoint_position;
         bool m_level_complete;
@@ -35,8 +61,19 @@ namespace world {
         int m_coins_collected;
         int m_total_coins;
         
+        // Coins, enemies and the player are queued here, one layer at a time, and drawn one
+        // call per texture page
+        core::SpriteBatch m_sprite_batch;
+        
         // Camera
         sf::View m_camera;
+        sf::Vector2f m_previous_camera_center;
+        
+        void begin_step();
+        void load_level(const LevelView& level, int level_id);
+        void update_streaming();
+        void spawn_chunk(int chunk);
+        void despawn_outside(const TileMap::ChunkRange& resident);
         
         void handle_collisions();
         void handle_enemy_collisions();
@@ -51,9 +88,14 @@ namespace world {
         bool is_level_complete() const { return m_level_complete; }
         bool is_game_over() const { return m_game_over; }
         int get_player_lives() const { return m_player ? m_player->get_lives() : 0; }
+        sf::Vector2f get_player_position() const { return m_player ? m_player->get_position() : sf::Vector2f(); }
         int get_coins_collected() const { return m_coins_collected; }
         int get_total_coins() const { return m_total_coins; }
         const sf::View& get_camera() const { return m_camera; }
+        sf::View get_render_camera(float alpha) const;
+        // Hash of the simulation state (player, live entities, spawn flags, counters), used
+        // by replays to check that playback reproduced the recorded run exactly
+        std::uint64_t compute_state_hash() const;
     };
 
 } // namespace world
@@ -0,0 +1,100 @@
+// Level compiler
+// Converts text levels to the binary format of world::CompiledLevel, which the game and
+// tools load by mapping the file instead of parsing text.
+//
+// Usage: level_compiler INPUT.txt OUTPUT.plvl
+//        level_compiler --custom LEVELS OUTPUT_DIR        (every level, as level_<id>.plvl)
+//                       LEVELS is a custom levels directory or an old single-file save;
+//                       OUTPUT_DIR may be that same directory, where the game loads them
+//        level_compiler --check FILE.plvl                 (validate and print a summary)
+
+#include "world/CompiledLevel.hpp"
+#include "world/LevelParser.hpp"
+#include "core/CustomLevelManager.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+    void print_usage() {
+        std::cout << "Usage: level_compiler INPUT.txt OUTPUT.plvl" << std::endl
+                  << "       level_compiler --custom LEVELS OUTPUT_DIR" << std::endl
+                  << "       level_compiler --check FILE.plvl" << std::endl;
+    }
+
+    void print_summary(const std::filesystem::path& path, const world::LevelView& level) {
+        std::cout << path.string() << ": " << level.width << "x" << level.height << " tiles, "
+                  << level.spawns.size() << " spawns (" << level.coin_count << " coins), "
+                  << level.checkpoints.size() << " checkpoints" << std::endl;
+    }
+
+    bool compile(const std::string& text, const std::filesystem::path& output) {
+        world::LevelDescription level = world::parse_level(text);
+        if (!world::save_compiled_level(output, level.view())) return false;
+        print_summary(output, level.view());
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc != 3 && argc != 4) {
+        print_usage();
+        return 1;
+    }
+    std::string mode = argv[1];
+
+    if (mode == "--check" && argc == 3) {
+        auto level = world::CompiledLevel::open(argv[2]);
+        if (!level) return 1;
+        print_summary(argv[2], level->view());
+        return 0;
+    }
+
+    if (mode == "--custom" && argc == 4) {
+        std::optional<std::vector<core::CustomLevel>> levels;
+        if (std::filesystem::is_directory(argv[2])) {
+            if (auto index = core::CustomLevelManager::read_index(argv[2])) {
+                levels.emplace();
+                for (const auto& info : *index) {
+                    auto data = core::CustomLevelManager::read_level_data(argv[2], info.id);
+                    if (!data) {
+                        std::cerr << "[ERROR] Missing data for custom level " << info.id << std::endl;
+                        return 1;
+                    }
+                    levels->push_back(core::CustomLevel{info.id, info.name, std::move(*data)});
+                }
+            }
+        } else {
+            levels = core::CustomLevelManager::read_levels_file(argv[2]);
+        }
+        if (!levels) {
+            std::cerr << "[ERROR] Cannot open custom levels: " << argv[2] << std::endl;
+            return 1;
+        }
+        std::filesystem::path output_dir = argv[3];
+        std::error_code error;
+        std::filesystem::create_directories(output_dir, error);
+        for (const auto& level : *levels) {
+            if (!compile(level.data, core::CustomLevelManager::compiled_level_file(output_dir, level.id))) return 1;
+        }
+        return 0;
+    }
+
+    if (argc == 3 && mode.rfind("--", 0) != 0) {
+        std::ifstream file(argv[1]);
+        if (!file) {
+            std::cerr << "[ERROR] Cannot open level file: " << argv[1] << std::endl;
+            return 1;
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return compile(buffer.str(), argv[2]) ? 0 : 1;
+    }
+
+    print_usage();
+    return 1;
+}